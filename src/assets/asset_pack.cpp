@@ -0,0 +1,83 @@
+#include "assets/asset_pack.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "assets/rle.hpp"
+
+namespace game {
+
+bool AssetPack::open(const std::string& path, std::string* error) {
+    index_ = nullptr;
+    count_ = 0;
+    decoded_.clear();
+    if (!file_.open(path, error)) return false;
+
+    pack::Header header;
+    if (file_.size() < sizeof header) {
+        if (error) *error = path + ": too small to be an asset pack";
+        return false;
+    }
+    std::memcpy(&header, file_.data(), sizeof header);
+    if (std::memcmp(header.magic, pack::kMagic, sizeof header.magic) != 0 || header.version != pack::kVersion) {
+        if (error) *error = path + ": not a version " + std::to_string(pack::kVersion) + " asset pack";
+        return false;
+    }
+    const std::uint64_t index_bytes = static_cast<std::uint64_t>(header.entry_count) * sizeof(pack::Entry);
+    if (header.index_offset % alignof(pack::Entry) != 0 || header.index_offset > file_.size() ||
+        index_bytes > file_.size() - header.index_offset) {
+        if (error) *error = path + ": corrupt index";
+        return false;
+    }
+
+    index_ = reinterpret_cast<const pack::Entry*>(file_.data() + header.index_offset);
+    count_ = header.entry_count;
+    for (std::size_t i = 0; i < count_; ++i) {
+        const pack::Entry& e = index_[i];
+        if (e.offset > file_.size() || e.stored_size > file_.size() - e.offset) {
+            if (error) *error = path + ": entry " + std::string(e.name, strnlen(e.name, sizeof e.name)) +
+                                " points outside the file";
+            index_ = nullptr;
+            count_ = 0;
+            return false;
+        }
+    }
+    decoded_.resize(count_);
+    return true;
+}
+
+const pack::Entry* AssetPack::find(const std::string& name) const {
+    if (name.size() >= sizeof(pack::Entry::name)) return nullptr;
+    const pack::Entry* end = index_ + count_;
+    const pack::Entry* it = std::lower_bound(index_, end, name, [](const pack::Entry& e, const std::string& key) {
+        return std::strncmp(e.name, key.c_str(), sizeof e.name) < 0;
+    });
+    if (it == end || std::strncmp(it->name, name.c_str(), sizeof it->name) != 0) return nullptr;
+    return it;
+}
+
+AssetPack::Bytes AssetPack::bytes(const pack::Entry& entry) {
+    const std::uint8_t* stored = file_.data() + entry.offset;
+    if (entry.codec == pack::Codec::None) {
+        if (entry.stored_size != entry.raw_size) return {};
+        return {stored, static_cast<std::size_t>(entry.stored_size)};
+    }
+
+    const std::size_t i = static_cast<std::size_t>(&entry - index_);
+    if (i >= count_) return {};
+    if (!decoded_[i]) {
+        // Check the claimed size against what the stored bytes can expand
+        // to before allocating for it.
+        if (entry.raw_size / kRleMaxExpansion > entry.stored_size) return {};
+        auto out = std::make_unique<std::vector<std::uint8_t>>(static_cast<std::size_t>(entry.raw_size));
+        const std::size_t size = static_cast<std::size_t>(entry.stored_size);
+        bool ok = false;
+        if (entry.codec == pack::Codec::Rle) ok = rle_decode(stored, size, out->data(), out->size());
+        if (entry.codec == pack::Codec::Rle32) ok = rle32_decode(stored, size, out->data(), out->size());
+        if (!ok) return {};
+        decoded_[i] = std::move(out);
+    }
+    return {decoded_[i]->data(), decoded_[i]->size()};
+}
+
+} // namespace game
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "assets/mapped_file.hpp"
+#include "assets/pack_format.hpp"
+
+namespace game {
+
+// Read side of an asset pack. open() maps the file and validates the header
+// and index only; no payload is touched until someone asks for it.
+// Uncompressed payloads are served straight from the mapping, compressed ones
+// are decoded on first request and cached for the life of the pack.
+class AssetPack {
+public:
+    struct Bytes {
+        const std::uint8_t* data = nullptr;
+        std::size_t size = 0;
+    };
+
+    bool open(const std::string& path, std::string* error);
+
+    // Binary search over the sorted index; nullptr if absent.
+    const pack::Entry* find(const std::string& name) const;
+
+    // Decoded payload, or an empty Bytes if the entry is corrupt.
+    Bytes bytes(const pack::Entry& entry);
+
+    std::size_t entry_count() const { return count_; }
+    const pack::Entry& entry(std::size_t i) const { return index_[i]; }
+    std::size_t mapped_size() const { return file_.size(); }
+
+private:
+    MappedFile file_;
+    const pack::Entry* index_ = nullptr;
+    std::size_t count_ = 0;
+    // Parallel to the index; null until a compressed entry is first decoded.
+    std::vector<std::unique_ptr<std::vector<std::uint8_t>>> decoded_;
+};
+
+} // namespace game
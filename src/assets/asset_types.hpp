@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+// RGBA8 pixels, R in the lowest byte (SDL_PIXELFORMAT_RGBA32 order).
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint32_t> pixels;
+};
+
+// Interleaved signed 16-bit PCM.
+struct SoundClip {
+    std::uint32_t sample_rate = 0;
+    std::uint32_t channels = 0;
+    std::vector<std::int16_t> samples;
+
+    std::size_t frames() const { return channels ? samples.size() / channels : 0; }
+};
+
+} // namespace game
@@ -0,0 +1,87 @@
+#include "assets/atlas_packer.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace game {
+
+namespace {
+
+constexpr int kGutter = 1;
+
+void blit(Image& page, const Image& src, int x, int y) {
+    for (int row = 0; row < src.height; ++row) {
+        std::copy_n(src.pixels.begin() + static_cast<std::ptrdiff_t>(row) * src.width, src.width,
+                    page.pixels.begin() + static_cast<std::ptrdiff_t>(y + row) * page.width + x);
+    }
+}
+
+Image blank_page(int size) {
+    Image page;
+    page.width = size;
+    page.height = size;
+    page.pixels.assign(static_cast<std::size_t>(size) * size, 0u);
+    return page;
+}
+
+} // namespace
+
+bool pack_atlases(const std::vector<NamedImage>& sprites, int page_size, std::vector<Image>& pages,
+                  std::vector<PackedSprite>& placed, std::string* error) {
+    pages.clear();
+    placed.clear();
+
+    std::vector<std::size_t> order(sprites.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    // Tallest first keeps shelves tight; ties by name so output is stable.
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (sprites[a].image.height != sprites[b].image.height) {
+            return sprites[a].image.height > sprites[b].image.height;
+        }
+        return sprites[a].name < sprites[b].name;
+    });
+
+    int shelf_x = kGutter, shelf_y = kGutter, shelf_h = 0;
+    for (std::size_t idx : order) {
+        const NamedImage& s = sprites[idx];
+        const int w = s.image.width;
+        const int h = s.image.height;
+        if (w + 2 * kGutter > page_size || h + 2 * kGutter > page_size) {
+            if (error) *error = s.name + " does not fit in a " + std::to_string(page_size) + "px page";
+            return false;
+        }
+        if (pages.empty()) pages.push_back(blank_page(page_size));
+        if (shelf_x + w + kGutter > page_size) {
+            shelf_x = kGutter;
+            shelf_y += shelf_h + kGutter;
+            shelf_h = 0;
+        }
+        if (shelf_y + h + kGutter > page_size) {
+            pages.push_back(blank_page(page_size));
+            shelf_x = kGutter;
+            shelf_y = kGutter;
+            shelf_h = 0;
+        }
+
+        blit(pages.back(), s.image, shelf_x, shelf_y);
+        placed.push_back({s.name, static_cast<int>(pages.size() - 1), shelf_x, shelf_y, w, h});
+        shelf_x += w + kGutter;
+        shelf_h = std::max(shelf_h, h);
+    }
+
+    // The last page is usually part-filled: trim it to the smallest
+    // power-of-two height that holds its shelves.
+    if (!pages.empty()) {
+        const int used = shelf_y + shelf_h + kGutter;
+        int height = 16;
+        while (height < used) height *= 2;
+        if (height < page_size) {
+            Image& last = pages.back();
+            last.height = height;
+            last.pixels.resize(static_cast<std::size_t>(last.width) * height);
+        }
+    }
+    return true;
+}
+
+} // namespace game
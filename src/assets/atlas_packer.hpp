@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "assets/asset_types.hpp"
+
+namespace game {
+
+struct NamedImage {
+    std::string name;
+    Image image;
+};
+
+// Where a source image ended up.
+struct PackedSprite {
+    std::string name;
+    int page = 0;
+    int x = 0, y = 0, w = 0, h = 0;
+};
+
+// Shelf packer: sprites are placed tallest first, left to right in rows, with
+// a one-pixel transparent gutter so linear filtering never bleeds between
+// neighbours. Opens a new page when one fills. Returns false if a single
+// sprite is larger than a page.
+bool pack_atlases(const std::vector<NamedImage>& sprites, int page_size, std::vector<Image>& pages,
+                  std::vector<PackedSprite>& placed, std::string* error);
+
+} // namespace game
@@ -0,0 +1,118 @@
+#include "assets/game_assets.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace game {
+
+namespace {
+
+std::uint32_t read_u32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// Looks up `name` and checks its type; returns the decoded bytes.
+bool fetch(AssetPack& pack, const std::string& name, pack::AssetType type, AssetPack::Bytes& out,
+           std::string* error) {
+    const pack::Entry* e = pack.find(name);
+    if (!e) return fail(error, "asset pack has no " + name);
+    if (e->type != type) return fail(error, name + " has the wrong asset type");
+    out = pack.bytes(*e);
+    if (!out.data) return fail(error, name + " is corrupt");
+    return true;
+}
+
+} // namespace
+
+std::string pack_atlas_name(int page) { return "atlas/" + std::to_string(page); }
+std::string pack_level_name(const std::string& level) { return "level/" + level; }
+std::string pack_sound_name(const std::string& sound) { return "sound/" + sound; }
+
+bool load_sprite_registry(AssetPack& pack, SpriteRegistry& out, std::string* error) {
+    AssetPack::Bytes table;
+    if (!fetch(pack, kPackSpriteTable, pack::AssetType::SpriteTable, table, error)) return false;
+    if (table.size < 4) return fail(error, "sprite table is truncated");
+    const std::uint32_t count = read_u32(table.data);
+    if (table.size < 4 + static_cast<std::size_t>(count) * sizeof(pack::SpriteRecord)) {
+        return fail(error, "sprite table is truncated");
+    }
+
+    out = SpriteRegistry{};
+    for (int page = 0;; ++page) {
+        const pack::Entry* e = pack.find(pack_atlas_name(page));
+        if (!e) break;
+        AssetPack::Bytes px;
+        if (!fetch(pack, pack_atlas_name(page), pack::AssetType::Atlas, px, error)) return false;
+        TextureAtlas atlas;
+        atlas.width = static_cast<int>(read_u32(px.data));
+        atlas.height = static_cast<int>(read_u32(px.data + 4));
+        const std::size_t count_px = static_cast<std::size_t>(atlas.width) * atlas.height;
+        if (px.size != 8 + count_px * 4) return fail(error, pack_atlas_name(page) + " has the wrong size");
+        atlas.pixels.resize(count_px);
+        std::memcpy(atlas.pixels.data(), px.data + 8, count_px * 4);
+        out.atlases.push_back(std::move(atlas));
+    }
+
+    bool found[kSpriteCount] = {};
+    for (std::uint32_t i = 0; i < count; ++i) {
+        pack::SpriteRecord r;
+        std::memcpy(&r, table.data + 4 + i * sizeof r, sizeof r);
+        if (r.atlas >= out.atlases.size()) return fail(error, "sprite table references a missing atlas page");
+        const std::string name(r.name, strnlen(r.name, sizeof r.name));
+        for (int id = 0; id < kSpriteCount; ++id) {
+            if (name != sprite_name(static_cast<SpriteId>(id))) continue;
+            const TextureAtlas& atlas = out.atlases[r.atlas];
+            const float iw = 1.0f / static_cast<float>(atlas.width);
+            const float ih = 1.0f / static_cast<float>(atlas.height);
+            out.frames[id] = {static_cast<std::uint16_t>(r.atlas), r.x * iw, r.y * ih, (r.x + r.w) * iw,
+                              (r.y + r.h) * ih};
+            found[id] = true;
+        }
+    }
+    for (int id = 0; id < kSpriteCount; ++id) {
+        if (!found[id]) {
+            return fail(error, std::string("asset pack has no sprite named ") + sprite_name(static_cast<SpriteId>(id)));
+        }
+    }
+    return true;
+}
+
+bool load_level(AssetPack& pack, const std::string& level, TileMap& out, std::string* error) {
+    AssetPack::Bytes b;
+    if (!fetch(pack, pack_level_name(level), pack::AssetType::Level, b, error)) return false;
+    if (b.size < 8) return fail(error, "level " + level + " is truncated");
+    const int w = static_cast<int>(read_u32(b.data));
+    const int h = static_cast<int>(read_u32(b.data + 4));
+    if (w <= 0 || h <= 0 || b.size != 8 + static_cast<std::size_t>(w) * h) {
+        return fail(error, "level " + level + " has the wrong size");
+    }
+    out = TileMap(w, h);
+    const std::uint8_t* tiles = b.data + 8;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) out.set(x, y, static_cast<Tile>(tiles[static_cast<std::size_t>(y) * w + x]));
+    }
+    return true;
+}
+
+bool load_sound(AssetPack& pack, const std::string& sound, SoundClip& out, std::string* error) {
+    AssetPack::Bytes b;
+    if (!fetch(pack, pack_sound_name(sound), pack::AssetType::Sound, b, error)) return false;
+    if (b.size < 12) return fail(error, "sound " + sound + " is truncated");
+    out.sample_rate = read_u32(b.data);
+    out.channels = read_u32(b.data + 4);
+    const std::size_t frames = read_u32(b.data + 8);
+    const std::size_t samples = frames * out.channels;
+    if (out.channels == 0 || b.size != 12 + samples * 2) return fail(error, "sound " + sound + " has the wrong size");
+    out.samples.resize(samples);
+    std::memcpy(out.samples.data(), b.data + 12, samples * 2);
+    return true;
+}
+
+} // namespace game
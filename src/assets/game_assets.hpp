@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "assets/asset_pack.hpp"
+#include "assets/asset_types.hpp"
+#include "render/atlas.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// Entry names inside the game's pack. Atlas pages are "atlas/0", "atlas/1", ...
+constexpr const char* kPackSpriteTable = "sprites";
+std::string pack_atlas_name(int page);
+std::string pack_level_name(const std::string& level);
+std::string pack_sound_name(const std::string& sound);
+
+// Decodes every atlas page plus the frames of all SpriteIds. Fails if any
+// SpriteId has no sprite of the same name in the pack.
+bool load_sprite_registry(AssetPack& pack, SpriteRegistry& out, std::string* error);
+
+bool load_level(AssetPack& pack, const std::string& level, TileMap& out, std::string* error);
+bool load_sound(AssetPack& pack, const std::string& sound, SoundClip& out, std::string* error);
+
+} // namespace game
@@ -0,0 +1,158 @@
+#include "assets/level_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "assets/rle.hpp"
+
+namespace game {
+
+namespace {
+
+constexpr char kMagic[4] = {'S', 'G', 'L', 'V'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kChunkTiles = TileChunk::kSize * TileChunk::kSize;
+// Bounds on a chunk's encoded size. Every control byte yields at least one
+// tile for at most two stored bytes, and at most kRleMaxExpansion tiles per
+// stored byte.
+constexpr std::size_t kMaxChunkBytes = 2 * kChunkTiles;
+constexpr std::size_t kMinChunkBytes = (kChunkTiles + kRleMaxExpansion - 1) / kRleMaxExpansion;
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+static_assert(sizeof(Header) == 16, "level header layout is part of the file format");
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+int chunk_count(int tiles) {
+    return (tiles + TileChunk::kMask) >> TileChunk::kShift;
+}
+
+} // namespace
+
+bool save_level_file(const std::string& path, const TileMap& map, std::string* error) {
+    const int cx_n = map.chunks_x();
+    const int cy_n = map.chunks_y();
+    const std::size_t chunks = static_cast<std::size_t>(cx_n) * cy_n;
+    std::vector<std::vector<std::uint8_t>> payloads(chunks);
+    for (int cy = 0; cy < cy_n; ++cy) {
+        for (int cx = 0; cx < cx_n; ++cx) {
+            const TileChunk& c = map.chunk(cx, cy);
+            payloads[static_cast<std::size_t>(cy) * cx_n + cx] =
+                rle_encode(reinterpret_cast<const std::uint8_t*>(c.tiles.data()), kChunkTiles);
+        }
+    }
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof header.magic);
+    header.version = kVersion;
+    header.width = static_cast<std::uint32_t>(map.width());
+    header.height = static_cast<std::uint32_t>(map.height());
+    std::vector<std::uint32_t> table(chunks * 2);
+    std::uint64_t offset = sizeof header + table.size() * sizeof(std::uint32_t);
+    for (std::size_t i = 0; i < chunks; ++i) {
+        table[i * 2] = static_cast<std::uint32_t>(offset);
+        table[i * 2 + 1] = static_cast<std::uint32_t>(payloads[i].size());
+        offset += payloads[i].size();
+    }
+    if (offset > UINT32_MAX) return fail(error, path + ": level too large for the chunk table");
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return fail(error, "cannot write " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof header);
+    out.write(reinterpret_cast<const char*>(table.data()),
+              static_cast<std::streamsize>(table.size() * sizeof(std::uint32_t)));
+    for (const auto& p : payloads) {
+        out.write(reinterpret_cast<const char*>(p.data()), static_cast<std::streamsize>(p.size()));
+    }
+    if (!out) return fail(error, "cannot write " + path);
+    return true;
+}
+
+bool load_level_file(const std::string& path, TileMap& out, std::string* error) {
+    LevelFile file;
+    if (!file.open(path, error)) return false;
+    TileMap map(file.width(), file.height());
+    std::vector<Tile> tiles(kChunkTiles);
+    for (int cy = 0; cy < file.chunks_y(); ++cy) {
+        for (int cx = 0; cx < file.chunks_x(); ++cx) {
+            if (!file.read_chunk(cx, cy, tiles.data(), error)) return false;
+            map.page_in(cx, cy, tiles.data());
+        }
+    }
+    out = std::move(map);
+    return true;
+}
+
+bool LevelFile::open(const std::string& path, std::string* error) {
+    path_ = path;
+    in_.open(path, std::ios::binary);
+    if (!in_) return fail(error, "cannot open " + path);
+    Header header;
+    if (!in_.read(reinterpret_cast<char*>(&header), sizeof header)) return fail(error, path + " is truncated");
+    if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0) return fail(error, path + " is not a level file");
+    if (header.version != kVersion) return fail(error, path + " has an unsupported version");
+    if (header.width == 0 || header.height == 0 || header.width > (1u << 20) || header.height > (1u << 20)) {
+        return fail(error, path + " has a bad level size");
+    }
+    width_ = static_cast<int>(header.width);
+    height_ = static_cast<int>(header.height);
+    chunks_x_ = chunk_count(width_);
+    chunks_y_ = chunk_count(height_);
+
+    // Every size and offset below comes from the file, so check each one
+    // against the file before allocating for it.
+    in_.seekg(0, std::ios::end);
+    const std::streamoff end = in_.tellg();
+    in_.seekg(static_cast<std::streamoff>(sizeof header));
+    if (end < 0 || !in_) return fail(error, "cannot read " + path);
+    const auto file_size = static_cast<std::uint64_t>(end);
+    const std::uint64_t chunks = static_cast<std::uint64_t>(chunks_x_) * static_cast<std::uint64_t>(chunks_y_);
+    const std::uint64_t data_start = sizeof header + chunks * sizeof(ChunkEntry);
+    if (data_start > file_size) return fail(error, path + " has a truncated chunk table");
+
+    table_.resize(static_cast<std::size_t>(chunks));
+    if (!in_.read(reinterpret_cast<char*>(table_.data()),
+                  static_cast<std::streamsize>(table_.size() * sizeof(ChunkEntry)))) {
+        return fail(error, path + " has a truncated chunk table");
+    }
+    std::uint32_t largest = 0;
+    for (const ChunkEntry& e : table_) {
+        if (e.offset < data_start || e.offset > file_size || e.size > file_size - e.offset ||
+            e.size < kMinChunkBytes || e.size > kMaxChunkBytes) {
+            return fail(error, path + " has a corrupt chunk table");
+        }
+        largest = std::max(largest, e.size);
+    }
+    buffer_.resize(largest);
+    return true;
+}
+
+bool LevelFile::read_chunk(int cx, int cy, Tile* out, std::string* error) {
+    if (cx < 0 || cy < 0 || cx >= chunks_x_ || cy >= chunks_y_) return fail(error, "chunk out of range");
+    const ChunkEntry& e = table_[static_cast<std::size_t>(cy) * chunks_x_ + cx];
+    in_.clear();
+    in_.seekg(static_cast<std::streamoff>(e.offset));
+    if (!in_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(e.size)) ||
+        !rle_decode(buffer_.data(), e.size, reinterpret_cast<std::uint8_t*>(out), kChunkTiles)) {
+        return fail(error, path_ + ": chunk " + std::to_string(cx) + "," + std::to_string(cy) + " is corrupt");
+    }
+    // Collision reads any nonzero byte as solid, so reject tiles this build
+    // does not know rather than guess.
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(out);
+    const auto unknown = [](std::uint8_t b) { return b > static_cast<std::uint8_t>(Tile::Solid); };
+    if (std::any_of(bytes, bytes + kChunkTiles, unknown)) {
+        return fail(error, path_ + ": chunk " + std::to_string(cx) + "," + std::to_string(cy) + " has an unknown tile");
+    }
+    return true;
+}
+
+} // namespace game
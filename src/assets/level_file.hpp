@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// Chunked level files ("SGLV"): a 16-byte header (magic, version, width and
+// height in tiles), an (offset, size) entry per chunk in row-major chunk
+// order, then each chunk's TileChunk::kSize^2 tile bytes, byte-RLE
+// compressed. Any one chunk is a single seek and read, which is what lets a
+// LevelStreamer page a level in without loading all of it.
+bool save_level_file(const std::string& path, const TileMap& map, std::string* error);
+
+// Loads every chunk of a level file into a fully resident map.
+bool load_level_file(const std::string& path, TileMap& out, std::string* error);
+
+// Random access to the chunks of a level file. Only the header and chunk
+// table are held in memory; read_chunk() does the I/O, so call it from
+// whichever thread should block on the disk.
+class LevelFile {
+public:
+    // Fails unless the chunk table and every chunk it lists fit in the file.
+    bool open(const std::string& path, std::string* error);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int chunks_x() const { return chunks_x_; }
+    int chunks_y() const { return chunks_y_; }
+
+    // Decodes chunk (cx, cy) into TileChunk::kSize^2 row-major tiles,
+    // failing on tile values outside the Tile enum. Does not allocate once
+    // the file is open.
+    bool read_chunk(int cx, int cy, Tile* out, std::string* error);
+
+private:
+    struct ChunkEntry {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    std::string path_;
+    std::ifstream in_;
+    int width_ = 0;
+    int height_ = 0;
+    int chunks_x_ = 0;
+    int chunks_y_ = 0;
+    std::vector<ChunkEntry> table_;
+    std::vector<std::uint8_t> buffer_;
+};
+
+} // namespace game
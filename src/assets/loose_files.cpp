@@ -0,0 +1,199 @@
+#include "assets/loose_files.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace game {
+
+namespace {
+
+bool read_file(const std::string& path, std::vector<std::uint8_t>& out, std::string* error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    out.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!in) {
+        if (error) *error = "short read on " + path;
+        return false;
+    }
+    return true;
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// Reads one whitespace-delimited header token, skipping '#' comments.
+std::string next_token(const std::vector<std::uint8_t>& buf, std::size_t& pos) {
+    for (;;) {
+        while (pos < buf.size() && std::isspace(buf[pos])) ++pos;
+        if (pos < buf.size() && buf[pos] == '#') {
+            while (pos < buf.size() && buf[pos] != '\n') ++pos;
+            continue;
+        }
+        break;
+    }
+    std::string tok;
+    while (pos < buf.size() && !std::isspace(buf[pos])) tok.push_back(static_cast<char>(buf[pos++]));
+    return tok;
+}
+
+std::uint32_t read_u32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+           static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+}
+
+std::uint16_t read_u16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | p[1] << 8);
+}
+
+void put_u32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+void put_u16(std::vector<std::uint8_t>& out, std::uint16_t v) {
+    out.push_back(static_cast<std::uint8_t>(v));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+
+bool write_file(const std::string& path, const std::vector<std::uint8_t>& data, std::string* error) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!out) return fail(error, "cannot write " + path);
+    return true;
+}
+
+} // namespace
+
+bool load_image(const std::string& path, Image& out, std::string* error) {
+    std::vector<std::uint8_t> buf;
+    if (!read_file(path, buf, error)) return false;
+
+    std::size_t pos = 0;
+    const std::string magic = next_token(buf, pos);
+    int width = 0, height = 0, depth = 0, maxval = 0;
+    if (magic == "P6") {
+        width = std::atoi(next_token(buf, pos).c_str());
+        height = std::atoi(next_token(buf, pos).c_str());
+        maxval = std::atoi(next_token(buf, pos).c_str());
+        depth = 3;
+    } else if (magic == "P7") {
+        for (std::string key = next_token(buf, pos); key != "ENDHDR"; key = next_token(buf, pos)) {
+            if (key.empty()) return fail(error, path + ": truncated PAM header");
+            const std::string value = next_token(buf, pos);
+            if (key == "WIDTH") width = std::atoi(value.c_str());
+            else if (key == "HEIGHT") height = std::atoi(value.c_str());
+            else if (key == "DEPTH") depth = std::atoi(value.c_str());
+            else if (key == "MAXVAL") maxval = std::atoi(value.c_str());
+        }
+    } else {
+        return fail(error, path + ": not a PAM/PPM image");
+    }
+    ++pos;  // single whitespace byte after the header
+
+    if (width <= 0 || height <= 0 || maxval != 255 || (depth != 3 && depth != 4)) {
+        return fail(error, path + ": unsupported image (need 8-bit RGB or RGBA)");
+    }
+    const std::size_t count = static_cast<std::size_t>(width) * height;
+    if (pos + count * depth > buf.size()) return fail(error, path + ": truncated pixel data");
+
+    out.width = width;
+    out.height = height;
+    out.pixels.resize(count);
+    const std::uint8_t* p = buf.data() + pos;
+    for (std::size_t i = 0; i < count; ++i, p += depth) {
+        const std::uint32_t a = depth == 4 ? p[3] : 255u;
+        out.pixels[i] = p[0] | static_cast<std::uint32_t>(p[1]) << 8 | static_cast<std::uint32_t>(p[2]) << 16 | a << 24;
+    }
+    return true;
+}
+
+bool save_pam(const std::string& path, const Image& image, std::string* error) {
+    char header[128];
+    const int len = std::snprintf(header, sizeof header,
+                                  "P7\nWIDTH %d\nHEIGHT %d\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n",
+                                  image.width, image.height);
+    std::vector<std::uint8_t> data(header, header + len);
+    for (std::uint32_t px : image.pixels) put_u32(data, px);
+    return write_file(path, data, error);
+}
+
+bool load_wav(const std::string& path, SoundClip& out, std::string* error) {
+    std::vector<std::uint8_t> buf;
+    if (!read_file(path, buf, error)) return false;
+    if (buf.size() < 12 || std::memcmp(buf.data(), "RIFF", 4) != 0 || std::memcmp(buf.data() + 8, "WAVE", 4) != 0) {
+        return fail(error, path + ": not a RIFF WAVE file");
+    }
+
+    bool have_format = false;
+    std::size_t pos = 12;
+    while (pos + 8 <= buf.size()) {
+        const std::uint8_t* chunk = buf.data() + pos;
+        const std::uint32_t size = read_u32(chunk + 4);
+        const std::uint8_t* body = chunk + 8;
+        if (pos + 8 + size > buf.size()) return fail(error, path + ": truncated chunk");
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            const std::uint16_t format = read_u16(body);
+            const std::uint16_t bits = read_u16(body + 14);
+            if (format != 1 || bits != 16) return fail(error, path + ": only 16-bit PCM is supported");
+            out.channels = read_u16(body + 2);
+            out.sample_rate = read_u32(body + 4);
+            have_format = out.channels > 0;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!have_format) return fail(error, path + ": data chunk before fmt chunk");
+            out.samples.resize(size / 2);
+            for (std::size_t i = 0; i < out.samples.size(); ++i) {
+                out.samples[i] = static_cast<std::int16_t>(read_u16(body + i * 2));
+            }
+            return true;
+        }
+        pos += 8 + size + (size & 1u);
+    }
+    return fail(error, path + ": no data chunk");
+}
+
+bool save_wav(const std::string& path, const SoundClip& clip, std::string* error) {
+    const std::uint32_t data_bytes = static_cast<std::uint32_t>(clip.samples.size() * 2);
+    std::vector<std::uint8_t> data;
+    data.insert(data.end(), {'R', 'I', 'F', 'F'});
+    put_u32(data, 36 + data_bytes);
+    data.insert(data.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put_u32(data, 16);
+    put_u16(data, 1);
+    put_u16(data, static_cast<std::uint16_t>(clip.channels));
+    put_u32(data, clip.sample_rate);
+    put_u32(data, clip.sample_rate * clip.channels * 2);
+    put_u16(data, static_cast<std::uint16_t>(clip.channels * 2));
+    put_u16(data, 16);
+    data.insert(data.end(), {'d', 'a', 't', 'a'});
+    put_u32(data, data_bytes);
+    for (std::int16_t s : clip.samples) put_u16(data, static_cast<std::uint16_t>(s));
+    return write_file(path, data, error);
+}
+
+bool load_level_text(const std::string& path, TileMap& out, std::string* error) {
+    std::ifstream in(path);
+    if (!in) return fail(error, "cannot open " + path);
+    std::vector<std::string> rows;
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        rows.push_back(line);
+    }
+    while (!rows.empty() && rows.back().empty()) rows.pop_back();
+    if (rows.empty()) return fail(error, path + ": empty level");
+    out = TileMap::from_ascii(rows);
+    return true;
+}
+
+} // namespace game
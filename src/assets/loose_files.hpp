@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include "assets/asset_types.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// Source-format loaders used by the pack tool (and by the loose-file side of
+// the asset benchmark). None of these are used by the game at runtime.
+//
+// Images are binary Netpbm: PAM (P7, RGB or RGB_ALPHA) or PPM (P6), maxval 255.
+bool load_image(const std::string& path, Image& out, std::string* error);
+bool save_pam(const std::string& path, const Image& image, std::string* error);
+
+// RIFF WAVE, 16-bit PCM only.
+bool load_wav(const std::string& path, SoundClip& out, std::string* error);
+bool save_wav(const std::string& path, const SoundClip& clip, std::string* error);
+
+// Text level: one row per line, '#' solid, anything else empty.
+bool load_level_text(const std::string& path, TileMap& out, std::string* error);
+
+} // namespace game
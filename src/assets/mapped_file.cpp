@@ -0,0 +1,95 @@
+#include "assets/mapped_file.hpp"
+
+#include <cstdio>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GAME_HAVE_MMAP 1
+#else
+#define GAME_HAVE_MMAP 0
+#endif
+
+namespace game {
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        fallback_ = std::move(other.fallback_);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path, std::string* error) {
+    close();
+#if GAME_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        if (error) *error = "cannot stat " + path + " (or it is empty)";
+        return false;
+    }
+    void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        if (error) *error = "cannot mmap " + path;
+        return false;
+    }
+    data_ = static_cast<const std::uint8_t*>(p);
+    size_ = static_cast<std::size_t>(st.st_size);
+    mapped_ = true;
+    return true;
+#else
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        if (error) *error = "cannot open " + path;
+        return false;
+    }
+    std::fseek(f, 0, SEEK_END);
+    const long len = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    if (len <= 0) {
+        std::fclose(f);
+        if (error) *error = path + " is empty";
+        return false;
+    }
+    fallback_.resize(static_cast<std::size_t>(len));
+    const std::size_t got = std::fread(fallback_.data(), 1, fallback_.size(), f);
+    std::fclose(f);
+    if (got != fallback_.size()) {
+        fallback_.clear();
+        if (error) *error = "short read on " + path;
+        return false;
+    }
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#if GAME_HAVE_MMAP
+    if (mapped_ && data_) ::munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    fallback_.clear();
+}
+
+} // namespace game
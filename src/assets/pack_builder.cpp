@@ -0,0 +1,80 @@
+#include "assets/pack_builder.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "assets/atlas_packer.hpp"
+#include "assets/game_assets.hpp"
+#include "assets/loose_files.hpp"
+#include "assets/pack_writer.hpp"
+
+namespace game {
+
+namespace {
+
+std::string directory_of(const std::string& path) {
+    const std::size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+} // namespace
+
+bool build_pack(const std::string& manifest_path, const std::string& out_path, int page_size,
+                PackBuildStats* stats, std::string* error) {
+    std::ifstream manifest(manifest_path);
+    if (!manifest) {
+        if (error) *error = "cannot open " + manifest_path;
+        return false;
+    }
+    const std::string base = directory_of(manifest_path);
+
+    PackWriter writer;
+    std::vector<NamedImage> sprites;
+    PackBuildStats local;
+    int line_no = 0;
+    for (std::string line; std::getline(manifest, line);) {
+        ++line_no;
+        std::istringstream fields(line);
+        std::string kind, name, file;
+        if (!(fields >> kind) || kind[0] == '#') continue;
+        if (!(fields >> name >> file)) {
+            if (error) *error = manifest_path + ":" + std::to_string(line_no) + ": expected <kind> <name> <path>";
+            return false;
+        }
+        const std::string path = base + file;
+
+        if (kind == "sprite") {
+            NamedImage s{name, {}};
+            if (!load_image(path, s.image, error)) return false;
+            sprites.push_back(std::move(s));
+        } else if (kind == "level") {
+            TileMap map;
+            if (!load_level_text(path, map, error)) return false;
+            writer.add_level(pack_level_name(name), map);
+            ++local.levels;
+        } else if (kind == "sound") {
+            SoundClip clip;
+            if (!load_wav(path, clip, error)) return false;
+            writer.add_sound(pack_sound_name(name), clip);
+            ++local.sounds;
+        } else {
+            if (error) *error = manifest_path + ":" + std::to_string(line_no) + ": unknown asset kind " + kind;
+            return false;
+        }
+    }
+
+    std::vector<Image> pages;
+    std::vector<PackedSprite> placed;
+    if (!pack_atlases(sprites, page_size, pages, placed, error)) return false;
+    for (std::size_t i = 0; i < pages.size(); ++i) writer.add_atlas(pack_atlas_name(static_cast<int>(i)), pages[i]);
+    writer.add_sprite_table(kPackSpriteTable, placed);
+    local.sprites = sprites.size();
+    local.atlas_pages = pages.size();
+
+    if (!writer.write(out_path, error)) return false;
+    if (stats) *stats = local;
+    return true;
+}
+
+} // namespace game
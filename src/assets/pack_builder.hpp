@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace game {
+
+struct PackBuildStats {
+    std::size_t sprites = 0;
+    std::size_t atlas_pages = 0;
+    std::size_t levels = 0;
+    std::size_t sounds = 0;
+};
+
+// Reads a manifest and writes the asset pack it describes. Each non-empty,
+// non-comment line is
+//
+//   sprite <name> <image.pam|image.ppm>
+//   level  <name> <level.txt>
+//   sound  <name> <clip.wav>
+//
+// with paths relative to the manifest. Sprites are packed into page_size
+// square atlas pages and the sprite table records where each one went.
+bool build_pack(const std::string& manifest_path, const std::string& out_path, int page_size,
+                PackBuildStats* stats, std::string* error);
+
+} // namespace game
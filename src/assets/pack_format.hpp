@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout of an asset pack (.pack). All integers are little-endian;
+// the structs below are written and read with memcpy, which is correct on the
+// little-endian targets the game ships on.
+//
+//   PackHeader
+//   payloads...            each entry's bytes, 16-byte aligned
+//   PackEntry[entry_count] index, sorted by name, at header.index_offset
+//
+// Raw (decoded) payload layouts:
+//   Atlas        u32 width, u32 height, u32 rgba[width * height]
+//   SpriteTable  u32 count, SpriteRecord[count]
+//   Level        u32 width, u32 height, u8 tiles[width * height]
+//   Sound        u32 sample_rate, u32 channels, u32 frames, i16 samples[frames * channels]
+
+namespace game::pack {
+
+constexpr char kMagic[4] = {'S', 'G', 'P', 'K'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kAlignment = 16;
+
+enum class AssetType : std::uint32_t {
+    Atlas = 1,
+    SpriteTable = 2,
+    Level = 3,
+    Sound = 4,
+};
+
+enum class Codec : std::uint32_t {
+    None = 0,  // stored as-is; readers can use the mapped bytes directly
+    Rle = 1,   // byte run-length encoding, see rle.hpp
+    Rle32 = 2, // run-length encoding over 32-bit words, used for atlas pages
+};
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entry_count;
+    std::uint32_t reserved;
+    std::uint64_t index_offset;
+};
+static_assert(sizeof(Header) == 24, "pack header layout");
+
+struct Entry {
+    char name[48];  // NUL-padded
+    AssetType type;
+    Codec codec;
+    std::uint64_t offset;
+    std::uint64_t stored_size;
+    std::uint64_t raw_size;
+};
+static_assert(sizeof(Entry) == 80, "pack entry layout");
+
+struct SpriteRecord {
+    char name[32];  // NUL-padded
+    std::uint32_t atlas;
+    std::uint32_t x, y, w, h;  // pixels within the atlas page
+};
+static_assert(sizeof(SpriteRecord) == 52, "sprite record layout");
+
+} // namespace game::pack
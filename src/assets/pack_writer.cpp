@@ -0,0 +1,133 @@
+#include "assets/pack_writer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "assets/rle.hpp"
+
+namespace game {
+
+namespace {
+
+template <typename T>
+void append_pod(std::vector<std::uint8_t>& out, const T& value) {
+    const auto* p = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+void copy_name(char* dst, std::size_t cap, const std::string& name) {
+    std::memset(dst, 0, cap);
+    std::memcpy(dst, name.data(), std::min(name.size(), cap - 1));
+}
+
+} // namespace
+
+void PackWriter::add(const std::string& name, pack::AssetType type, std::vector<std::uint8_t> raw) {
+    add(name, type, std::move(raw), pack::Codec::Rle);
+}
+
+void PackWriter::add(const std::string& name, pack::AssetType type, std::vector<std::uint8_t> raw, pack::Codec codec) {
+    Pending p{};
+    copy_name(p.entry.name, sizeof p.entry.name, name);
+    p.entry.type = type;
+    p.entry.raw_size = raw.size();
+
+    // Stored entries are used straight from the mapping, so RLE has to save
+    // at least a quarter of the size to pay for its decode and copy.
+    std::vector<std::uint8_t> packed;
+    if (codec == pack::Codec::Rle) packed = rle_encode(raw.data(), raw.size());
+    if (codec == pack::Codec::Rle32) packed = rle32_encode(raw.data(), raw.size());
+    if (!packed.empty() && packed.size() <= raw.size() / 4 * 3) {
+        p.entry.codec = codec;
+        p.bytes = std::move(packed);
+    } else {
+        p.entry.codec = pack::Codec::None;
+        p.bytes = std::move(raw);
+    }
+    p.entry.stored_size = p.bytes.size();
+    entries_.push_back(std::move(p));
+}
+
+void PackWriter::add_atlas(const std::string& name, const Image& page) {
+    std::vector<std::uint8_t> raw;
+    raw.reserve(8 + page.pixels.size() * 4);
+    append_pod(raw, static_cast<std::uint32_t>(page.width));
+    append_pod(raw, static_cast<std::uint32_t>(page.height));
+    const auto* px = reinterpret_cast<const std::uint8_t*>(page.pixels.data());
+    raw.insert(raw.end(), px, px + page.pixels.size() * 4);
+    add(name, pack::AssetType::Atlas, std::move(raw), pack::Codec::Rle32);
+}
+
+void PackWriter::add_sprite_table(const std::string& name, const std::vector<PackedSprite>& sprites) {
+    std::vector<std::uint8_t> raw;
+    append_pod(raw, static_cast<std::uint32_t>(sprites.size()));
+    for (const PackedSprite& s : sprites) {
+        pack::SpriteRecord r{};
+        copy_name(r.name, sizeof r.name, s.name);
+        r.atlas = static_cast<std::uint32_t>(s.page);
+        r.x = static_cast<std::uint32_t>(s.x);
+        r.y = static_cast<std::uint32_t>(s.y);
+        r.w = static_cast<std::uint32_t>(s.w);
+        r.h = static_cast<std::uint32_t>(s.h);
+        append_pod(raw, r);
+    }
+    add(name, pack::AssetType::SpriteTable, std::move(raw));
+}
+
+void PackWriter::add_level(const std::string& name, const TileMap& map) {
+    std::vector<std::uint8_t> raw;
+    append_pod(raw, static_cast<std::uint32_t>(map.width()));
+    append_pod(raw, static_cast<std::uint32_t>(map.height()));
+    for (int y = 0; y < map.height(); ++y) {
+        for (int x = 0; x < map.width(); ++x) raw.push_back(static_cast<std::uint8_t>(map.at(x, y)));
+    }
+    add(name, pack::AssetType::Level, std::move(raw));
+}
+
+void PackWriter::add_sound(const std::string& name, const SoundClip& clip) {
+    std::vector<std::uint8_t> raw;
+    append_pod(raw, clip.sample_rate);
+    append_pod(raw, clip.channels);
+    append_pod(raw, static_cast<std::uint32_t>(clip.frames()));
+    const auto* p = reinterpret_cast<const std::uint8_t*>(clip.samples.data());
+    raw.insert(raw.end(), p, p + clip.samples.size() * 2);
+    add(name, pack::AssetType::Sound, std::move(raw));
+}
+
+bool PackWriter::write(const std::string& path, std::string* error) const {
+    std::vector<const Pending*> sorted;
+    for (const Pending& p : entries_) sorted.push_back(&p);
+    std::sort(sorted.begin(), sorted.end(), [](const Pending* a, const Pending* b) {
+        return std::strncmp(a->entry.name, b->entry.name, sizeof a->entry.name) < 0;
+    });
+
+    std::vector<std::uint8_t> out(sizeof(pack::Header), 0);
+    std::vector<pack::Entry> index;
+    for (const Pending* p : sorted) {
+        out.resize((out.size() + pack::kAlignment - 1) / pack::kAlignment * pack::kAlignment, 0);
+        pack::Entry e = p->entry;
+        e.offset = out.size();
+        out.insert(out.end(), p->bytes.begin(), p->bytes.end());
+        index.push_back(e);
+    }
+    out.resize((out.size() + pack::kAlignment - 1) / pack::kAlignment * pack::kAlignment, 0);
+
+    pack::Header header{};
+    std::memcpy(header.magic, pack::kMagic, sizeof header.magic);
+    header.version = pack::kVersion;
+    header.entry_count = static_cast<std::uint32_t>(index.size());
+    header.index_offset = out.size();
+    for (const pack::Entry& e : index) append_pod(out, e);
+    std::memcpy(out.data(), &header, sizeof header);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+        if (error) *error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace game
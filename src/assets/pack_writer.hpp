@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "assets/asset_types.hpp"
+#include "assets/atlas_packer.hpp"
+#include "assets/pack_format.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// Builds an asset pack in memory and writes it in one go. Used by the
+// offline pack tool; the game itself only reads packs.
+class PackWriter {
+public:
+    // Payloads are compressed with `codec` (byte RLE by default) when that
+    // saves at least a quarter of their size; otherwise they are stored.
+    void add(const std::string& name, pack::AssetType type, std::vector<std::uint8_t> raw);
+    void add(const std::string& name, pack::AssetType type, std::vector<std::uint8_t> raw, pack::Codec codec);
+
+    void add_atlas(const std::string& name, const Image& page);
+    void add_sprite_table(const std::string& name, const std::vector<PackedSprite>& sprites);
+    void add_level(const std::string& name, const TileMap& map);
+    void add_sound(const std::string& name, const SoundClip& clip);
+
+    bool write(const std::string& path, std::string* error) const;
+
+private:
+    struct Pending {
+        pack::Entry entry;
+        std::vector<std::uint8_t> bytes;
+    };
+    std::vector<Pending> entries_;
+};
+
+} // namespace game
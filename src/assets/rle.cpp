@@ -0,0 +1,89 @@
+#include "assets/rle.hpp"
+
+#include <cstring>
+
+namespace game {
+
+namespace {
+
+// Shared by the byte and word codecs; T is the unit runs are counted in.
+template <typename T>
+std::vector<std::uint8_t> encode_units(const std::uint8_t* bytes, std::size_t size) {
+    const std::size_t count = size / sizeof(T);
+    std::vector<T> data(count);
+    std::memcpy(data.data(), bytes, count * sizeof(T));
+
+    std::vector<std::uint8_t> out;
+    out.reserve(size / 2 + 16);
+    auto put = [&out](const T* p, std::size_t n) {
+        const auto* b = reinterpret_cast<const std::uint8_t*>(p);
+        out.insert(out.end(), b, b + n * sizeof(T));
+    };
+    std::size_t i = 0;
+    while (i < count) {
+        std::size_t run = 1;
+        while (i + run < count && run < 129 && data[i + run] == data[i]) ++run;
+        if (run >= 2) {
+            out.push_back(static_cast<std::uint8_t>(run + 126));
+            put(&data[i], 1);
+            i += run;
+            continue;
+        }
+        // Literal span: up to the next run of two or more equal units.
+        std::size_t len = 1;
+        while (i + len < count && len < 128 && !(i + len + 1 < count && data[i + len] == data[i + len + 1])) ++len;
+        out.push_back(static_cast<std::uint8_t>(len - 1));
+        put(&data[i], len);
+        i += len;
+    }
+    return out;
+}
+
+template <typename T>
+bool decode_units(const std::uint8_t* data, std::size_t size, std::uint8_t* out, std::size_t out_size) {
+    if (out_size % sizeof(T) != 0) return false;
+    std::size_t in = 0;
+    std::size_t pos = 0;
+    while (in < size) {
+        const std::uint8_t c = data[in++];
+        if (c < 128) {
+            const std::size_t bytes = (static_cast<std::size_t>(c) + 1) * sizeof(T);
+            if (in + bytes > size || pos + bytes > out_size) return false;
+            std::memcpy(out + pos, data + in, bytes);
+            in += bytes;
+            pos += bytes;
+        } else {
+            const std::size_t len = static_cast<std::size_t>(c) - 126;
+            if (in + sizeof(T) > size || pos + len * sizeof(T) > out_size) return false;
+            if (sizeof(T) == 1) {
+                std::memset(out + pos, data[in], len);
+            } else {
+                for (std::size_t k = 0; k < len; ++k) std::memcpy(out + pos + k * sizeof(T), data + in, sizeof(T));
+            }
+            in += sizeof(T);
+            pos += len * sizeof(T);
+        }
+    }
+    return pos == out_size;
+}
+
+} // namespace
+
+std::vector<std::uint8_t> rle_encode(const std::uint8_t* data, std::size_t size) {
+    return encode_units<std::uint8_t>(data, size);
+}
+
+bool rle_decode(const std::uint8_t* data, std::size_t size, std::uint8_t* out, std::size_t out_size) {
+    return decode_units<std::uint8_t>(data, size, out, out_size);
+}
+
+std::vector<std::uint8_t> rle32_encode(const std::uint8_t* data, std::size_t size) {
+    if (size % 4 != 0) return {};
+    return encode_units<std::uint32_t>(data, size);
+}
+
+bool rle32_decode(const std::uint8_t* data, std::size_t size, std::uint8_t* out, std::size_t out_size) {
+    return decode_units<std::uint32_t>(data, size, out, out_size);
+}
+
+} // namespace game
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+// PackBits-style byte RLE. A control byte c < 128 is followed by c + 1
+// literal bytes; c >= 128 repeats the next byte c - 126 times (2..129).
+// Decodes at memcpy-like speed when runs are long.
+std::vector<std::uint8_t> rle_encode(const std::uint8_t* data, std::size_t size);
+
+// Decodes into exactly out_size bytes. Returns false on malformed input.
+bool rle_decode(const std::uint8_t* data, std::size_t size, std::uint8_t* out, std::size_t out_size);
+
+// The same scheme over 32-bit words, for RGBA pixel data: byte runs break
+// inside every pixel, word runs cover flat colour and transparent padding.
+// Sizes are in bytes and must be multiples of four.
+std::vector<std::uint8_t> rle32_encode(const std::uint8_t* data, std::size_t size);
+bool rle32_decode(const std::uint8_t* data, std::size_t size, std::uint8_t* out, std::size_t out_size);
+
+// Neither scheme decodes to more than this many bytes per encoded byte (a
+// two-byte run gives at most 129 bytes, a five-byte word run 516), so larger
+// claimed sizes mean corrupt input.
+constexpr std::size_t kRleMaxExpansion = 129;
+
+} // namespace game
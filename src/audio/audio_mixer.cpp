@@ -0,0 +1,249 @@
+#include "audio/audio_mixer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GAME_MIX_X86 1
+#else
+#define GAME_MIX_X86 0
+#endif
+
+namespace game {
+
+namespace {
+
+constexpr std::size_t kCommandCapacity = 256;
+constexpr float kS16Min = -32768.0f;
+constexpr float kS16Max = 32767.0f;
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// Same semantics as the SSE min/max, which the vector paths use to clamp.
+inline float vmin(float a, float b) { return a < b ? a : b; }
+inline float vmax(float a, float b) { return a > b ? a : b; }
+
+void mix_scalar(float* acc, const float* src, std::size_t begin, std::size_t end, float gain_l, float gain_r) {
+    for (std::size_t i = begin; i < end; i += 2) {
+        acc[i] += src[i] * gain_l;
+        acc[i + 1] += src[i + 1] * gain_r;
+    }
+}
+
+void convert_scalar(std::int16_t* out, const float* acc, std::size_t begin, std::size_t end, float gain) {
+    for (std::size_t i = begin; i < end; ++i) {
+        const float v = vmin(vmax(acc[i] * gain, kS16Min), kS16Max);
+        out[i] = static_cast<std::int16_t>(std::lrint(v));
+    }
+}
+
+#if GAME_MIX_X86
+
+std::size_t mix_sse2(float* acc, const float* src, std::size_t samples, float gain_l, float gain_r) {
+    const std::size_t n = samples & ~std::size_t{3};
+    const __m128 gain = _mm_setr_ps(gain_l, gain_r, gain_l, gain_r);
+    for (std::size_t i = 0; i < n; i += 4) {
+        _mm_storeu_ps(&acc[i], _mm_add_ps(_mm_loadu_ps(&acc[i]), _mm_mul_ps(_mm_loadu_ps(&src[i]), gain)));
+    }
+    return n;
+}
+
+std::size_t convert_sse2(std::int16_t* out, const float* acc, std::size_t samples, float gain) {
+    const std::size_t n = samples & ~std::size_t{7};
+    const __m128 g = _mm_set1_ps(gain);
+    const __m128 lo = _mm_set1_ps(kS16Min);
+    const __m128 hi = _mm_set1_ps(kS16Max);
+    for (std::size_t i = 0; i < n; i += 8) {
+        // Clamped first: cvtps turns out-of-range values into INT_MIN.
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&acc[i]), g), lo), hi);
+        const __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&acc[i + 4]), g), lo), hi);
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), packed);
+    }
+    return n;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GAME_TARGET_AVX2 __attribute__((target("avx2")))
+
+GAME_TARGET_AVX2 std::size_t mix_avx2(float* acc, const float* src, std::size_t samples, float gain_l,
+                                      float gain_r) {
+    const std::size_t n = samples & ~std::size_t{7};
+    const __m256 gain = _mm256_setr_ps(gain_l, gain_r, gain_l, gain_r, gain_l, gain_r, gain_l, gain_r);
+    for (std::size_t i = 0; i < n; i += 8) {
+        _mm256_storeu_ps(&acc[i],
+                         _mm256_add_ps(_mm256_loadu_ps(&acc[i]), _mm256_mul_ps(_mm256_loadu_ps(&src[i]), gain)));
+    }
+    return n;
+}
+#define GAME_MIX_AVX2 1
+#else
+#define GAME_MIX_AVX2 0
+#endif
+
+#endif // GAME_MIX_X86
+
+} // namespace
+
+void mix_stereo(float* acc, const float* src, std::size_t samples, float gain_l, float gain_r, SimdLevel level) {
+    std::size_t done = 0;
+#if GAME_MIX_X86
+#if GAME_MIX_AVX2
+    if (level == SimdLevel::Avx2) {
+        done = mix_avx2(acc, src, samples, gain_l, gain_r);
+    } else
+#endif
+    if (level != SimdLevel::Scalar) {
+        done = mix_sse2(acc, src, samples, gain_l, gain_r);
+    }
+#else
+    (void)level;
+#endif
+    mix_scalar(acc, src, done, samples, gain_l, gain_r);
+}
+
+void convert_to_s16(std::int16_t* out, const float* acc, std::size_t samples, float gain, SimdLevel level) {
+    std::size_t done = 0;
+#if GAME_MIX_X86
+    // Conversion runs once per buffer rather than once per voice, so SSE2
+    // is plenty even when AVX2 is available.
+    if (level != SimdLevel::Scalar) done = convert_sse2(out, acc, samples, gain);
+#else
+    (void)level;
+#endif
+    convert_scalar(out, acc, done, samples, gain);
+}
+
+AudioMixer::AudioMixer(std::uint32_t sample_rate, SimdLevel level)
+    : sample_rate_(sample_rate), level_(level), commands_(kCommandCapacity) {}
+
+int AudioMixer::add_clip(const SoundClip& clip, std::string* error) {
+    std::string problem;
+    if (clip.frames() == 0) {
+        problem = "sound clip is empty";
+    } else if (clip.channels != 1 && clip.channels != 2) {
+        problem = "sound clips must be mono or stereo";
+    } else if (clip.sample_rate != sample_rate_) {
+        problem = "sound clip is " + std::to_string(clip.sample_rate) + " Hz; the mixer runs at " +
+                  std::to_string(sample_rate_);
+    }
+    if (!problem.empty()) {
+        fail(error, problem);
+        return -1;
+    }
+
+    Clip c;
+    c.frames = clip.frames();
+    c.samples.resize(c.frames * kChannels);
+    for (std::size_t f = 0; f < c.frames; ++f) {
+        const std::int16_t* in = &clip.samples[f * clip.channels];
+        c.samples[f * 2] = static_cast<float>(in[0]);
+        c.samples[f * 2 + 1] = static_cast<float>(in[clip.channels - 1]);
+    }
+    clips_.push_back(std::move(c));
+    return static_cast<int>(clips_.size() - 1);
+}
+
+VoiceId AudioMixer::play(int clip, float volume, float pan, bool loop) {
+    if (clip < 0 || clip >= static_cast<int>(clips_.size())) return 0;
+    const VoiceId id = next_voice_;
+    if (!commands_.push({Op::Play, loop, clip, id, volume, pan})) {
+        ++commands_dropped_;
+        return 0;
+    }
+    next_voice_ = next_voice_ == UINT32_MAX ? 1 : next_voice_ + 1;
+    return id;
+}
+
+void AudioMixer::stop(VoiceId voice) {
+    send({Op::Stop, false, 0, voice, 0.0f, 0.0f});
+}
+
+void AudioMixer::set_volume(VoiceId voice, float volume, float pan) {
+    send({Op::SetVolume, false, 0, voice, volume, pan});
+}
+
+void AudioMixer::set_master_volume(float volume) {
+    send({Op::SetMaster, false, 0, 0, volume, 0.0f});
+}
+
+void AudioMixer::send(const Command& command) {
+    if (!commands_.push(command)) ++commands_dropped_;
+}
+
+void AudioMixer::apply(const Command& command) {
+    // Linear pan: the far side fades out, the near side stays at volume.
+    const float gain_l = command.volume * std::min(1.0f, 1.0f - command.pan);
+    const float gain_r = command.volume * std::min(1.0f, 1.0f + command.pan);
+    switch (command.op) {
+    case Op::Play: {
+        auto free = std::find_if(voices_.begin(), voices_.end(), [](const Voice& v) { return v.id == 0; });
+        if (free == voices_.end()) {
+            voices_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        *free = {command.voice, command.clip, command.loop, 0, gain_l, gain_r};
+        return;
+    }
+    case Op::Stop:
+    case Op::SetVolume:
+        // A voice that already finished is simply not found.
+        for (Voice& v : voices_) {
+            if (v.id != command.voice) continue;
+            if (command.op == Op::Stop) {
+                v.id = 0;
+            } else {
+                v.gain_l = gain_l;
+                v.gain_r = gain_r;
+            }
+        }
+        return;
+    case Op::SetMaster:
+        master_ = command.volume;
+        return;
+    }
+}
+
+void AudioMixer::mix_voice(Voice& voice, std::size_t frames) {
+    const Clip& clip = clips_[static_cast<std::size_t>(voice.clip)];
+    std::size_t offset = 0;
+    while (frames > 0 && voice.id != 0) {
+        const std::size_t n = std::min(frames, clip.frames - voice.pos);
+        mix_stereo(&acc_[offset * kChannels], &clip.samples[voice.pos * kChannels], n * kChannels, voice.gain_l,
+                   voice.gain_r, level_);
+        voice.pos += n;
+        offset += n;
+        frames -= n;
+        if (voice.pos == clip.frames) {
+            voice.pos = 0;
+            if (!voice.loop) voice.id = 0;
+        }
+    }
+}
+
+void AudioMixer::mix(std::int16_t* out, std::size_t frames) {
+    Command command;
+    while (commands_.pop(command)) apply(command);
+
+    while (frames > 0) {
+        const std::size_t n = std::min(frames, kBlockFrames);
+        std::fill_n(acc_.begin(), n * kChannels, 0.0f);
+        for (Voice& v : voices_) {
+            if (v.id != 0) mix_voice(v, n);
+        }
+        convert_to_s16(out, acc_.data(), n * kChannels, master_, level_);
+        out += n * kChannels;
+        frames -= n;
+    }
+
+    int active = 0;
+    for (const Voice& v : voices_) active += v.id != 0 ? 1 : 0;
+    active_voices_.store(active, std::memory_order_relaxed);
+}
+
+} // namespace game
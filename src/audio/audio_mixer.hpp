@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "assets/asset_types.hpp"
+#include "core/cpu_features.hpp"
+#include "core/spsc_queue.hpp"
+
+namespace game {
+
+// Identifies one playing sound; 0 is never a valid voice.
+using VoiceId = std::uint32_t;
+
+// Software mixer for an audio callback thread.
+//
+// Clips are converted once, up front, to stereo float at the mixer's rate.
+// After that the game thread only queues small commands (play, stop, volume)
+// on a lock-free SPSC ring, and the audio thread applies them at the start of
+// each mix() before summing the playing voices with SIMD. Neither side ever
+// waits on the other, so a slow frame can't starve the callback and a slow
+// callback can't stall the frame.
+class AudioMixer {
+public:
+    static constexpr int kChannels = 2;  // output is interleaved stereo
+    static constexpr int kMaxVoices = 32;
+    // Frames summed per pass; mix() loops for longer buffers.
+    static constexpr std::size_t kBlockFrames = 512;
+
+    explicit AudioMixer(std::uint32_t sample_rate, SimdLevel level = active_simd_level());
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    std::uint32_t sample_rate() const { return sample_rate_; }
+
+    // Setup, before the audio thread starts. Returns the clip's index for
+    // play(), or -1 if it is empty, not mono or stereo, or at another rate.
+    int add_clip(const SoundClip& clip, std::string* error);
+
+    // Game thread. Each call queues one command and returns immediately; it
+    // is dropped (play() returns 0) if the ring is full. pan runs from -1
+    // (left) to 1 (right).
+    VoiceId play(int clip, float volume = 1.0f, float pan = 0.0f, bool loop = false);
+    void stop(VoiceId voice);
+    void set_volume(VoiceId voice, float volume, float pan = 0.0f);
+    void set_master_volume(float volume);
+    std::uint64_t commands_dropped() const { return commands_dropped_; }
+
+    // Audio thread: applies the queued commands, then writes `frames`
+    // frames of interleaved signed 16-bit stereo. Never locks or allocates.
+    void mix(std::int16_t* out, std::size_t frames);
+
+    // Written by the audio thread, readable from any thread.
+    int active_voices() const { return active_voices_.load(std::memory_order_relaxed); }
+    // Plays that found every voice busy and were not started.
+    std::uint64_t voices_dropped() const { return voices_dropped_.load(std::memory_order_relaxed); }
+
+private:
+    enum class Op : std::uint8_t { Play, Stop, SetVolume, SetMaster };
+
+    struct Command {
+        Op op;
+        bool loop;
+        std::int32_t clip;
+        VoiceId voice;
+        float volume;
+        float pan;
+    };
+
+    struct Clip {
+        std::vector<float> samples;  // interleaved stereo
+        std::size_t frames = 0;
+    };
+
+    struct Voice {
+        VoiceId id = 0;  // 0 when free
+        std::int32_t clip = 0;
+        bool loop = false;
+        std::size_t pos = 0;  // next frame
+        float gain_l = 0.0f;
+        float gain_r = 0.0f;
+    };
+
+    void send(const Command& command);
+    void apply(const Command& command);
+    // Adds the voice's next `frames` frames into acc_, wrapping looped clips
+    // and freeing the voice when a one-shot clip ends.
+    void mix_voice(Voice& voice, std::size_t frames);
+
+    std::uint32_t sample_rate_;
+    SimdLevel level_;
+    std::vector<Clip> clips_;
+
+    // Game thread.
+    SpscQueue<Command> commands_;
+    VoiceId next_voice_ = 1;
+    std::uint64_t commands_dropped_ = 0;
+
+    // Audio thread.
+    std::array<Voice, kMaxVoices> voices_{};
+    float master_ = 1.0f;
+    alignas(32) std::array<float, kBlockFrames * kChannels> acc_{};
+    std::atomic<int> active_voices_{0};
+    std::atomic<std::uint64_t> voices_dropped_{0};
+};
+
+// The mixing kernels, exposed for the bench. Every level runs the same IEEE
+// operations per sample, so their output is bit-identical.
+//
+// acc[i] += src[i] * (i even ? gain_l : gain_r), for an even `samples`.
+void mix_stereo(float* acc, const float* src, std::size_t samples, float gain_l, float gain_r, SimdLevel level);
+// out[i] = acc[i] * gain, rounded to nearest and saturated to 16 bits.
+void convert_to_s16(std::int16_t* out, const float* acc, std::size_t samples, float gain, SimdLevel level);
+
+} // namespace game
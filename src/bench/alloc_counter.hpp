@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game::bench {
+
+// Number of global operator new calls made so far by any thread. The bench
+// binary replaces the global allocation functions to count them; the frame
+// suite compares the count around its update and render stages to prove
+// steady-state frames never touch the heap.
+std::uint64_t allocation_count();
+
+} // namespace game::bench
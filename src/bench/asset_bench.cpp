@@ -0,0 +1,222 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "assets/asset_pack.hpp"
+#include "assets/game_assets.hpp"
+#include "assets/loose_files.hpp"
+#include "assets/pack_builder.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/rng.hpp"
+#include "sim/levels.hpp"
+
+namespace game::bench {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr int kSprites = 400;
+constexpr int kLevels = 4;
+constexpr int kSounds = 8;
+constexpr int kRuns = 5;
+
+struct Corpus {
+    fs::path dir;
+    std::vector<std::string> sprite_files;
+    std::vector<std::string> level_files;
+    std::vector<std::string> sound_files;
+};
+
+// Writes a synthetic asset set shaped like a small game's: a few hundred
+// sprites, some levels and some short sounds, plus the manifest for it.
+bool write_corpus(Corpus& c, std::uint32_t seed, std::string* error) {
+    c.dir = fs::temp_directory_path() / "sdl_game_bench_assets";
+    std::error_code ec;
+    fs::remove_all(c.dir, ec);
+    fs::create_directories(c.dir, ec);
+    if (ec) {
+        if (error) *error = "cannot create " + c.dir.string();
+        return false;
+    }
+
+    Rng rng(seed);
+    std::ofstream manifest(c.dir / "manifest.txt");
+    for (int i = 0; i < kSprites; ++i) {
+        Image img;
+        img.width = rng.range(8, 48);
+        img.height = rng.range(8, 48);
+        img.pixels.resize(static_cast<std::size_t>(img.width) * img.height);
+        const std::uint32_t color = rng.next() | 0xff000000u;
+        for (std::size_t p = 0; p < img.pixels.size(); ++p) img.pixels[p] = (p % 7 == 0) ? 0u : color;
+        const std::string name = "sprite" + std::to_string(i);
+        if (!save_pam((c.dir / (name + ".pam")).string(), img, error)) return false;
+        c.sprite_files.push_back((c.dir / (name + ".pam")).string());
+        manifest << "sprite " << name << " " << name << ".pam\n";
+    }
+    for (int i = 0; i < kLevels; ++i) {
+        const TileMap map = make_generated_level(512, 64, seed + static_cast<std::uint32_t>(i));
+        const std::string name = "level" + std::to_string(i);
+        std::ofstream out(c.dir / (name + ".txt"));
+        for (int y = 0; y < map.height(); ++y) {
+            for (int x = 0; x < map.width(); ++x) out << (map.solid(x, y) ? '#' : ' ');
+            out << '\n';
+        }
+        c.level_files.push_back((c.dir / (name + ".txt")).string());
+        manifest << "level " << name << " " << name << ".txt\n";
+    }
+    for (int i = 0; i < kSounds; ++i) {
+        SoundClip clip;
+        clip.sample_rate = 44100;
+        clip.channels = 2;
+        clip.samples.resize(44100 * 2);
+        for (std::size_t s = 0; s < clip.samples.size(); ++s) {
+            clip.samples[s] = static_cast<std::int16_t>(static_cast<int>(rng.next() % 8192) - 4096);
+        }
+        const std::string name = "sound" + std::to_string(i);
+        if (!save_wav((c.dir / (name + ".wav")).string(), clip, error)) return false;
+        c.sound_files.push_back((c.dir / (name + ".wav")).string());
+        manifest << "sound " << name << " " << name << ".wav\n";
+    }
+    return true;
+}
+
+// What a loose-file game loads before its first frame: every sprite image (to
+// build textures from), the first level and the sounds.
+bool startup_loose(const Corpus& c, std::string* error) {
+    for (const std::string& f : c.sprite_files) {
+        Image img;
+        if (!load_image(f, img, error)) return false;
+    }
+    TileMap map;
+    if (!load_level_text(c.level_files[0], map, error)) return false;
+    for (const std::string& f : c.sound_files) {
+        SoundClip clip;
+        if (!load_wav(f, clip, error)) return false;
+    }
+    return true;
+}
+
+// The pack equivalent: map the file, decode the atlas pages and the first
+// level. Sounds and other levels stay untouched until first used.
+bool startup_packed(const std::string& path, std::string* error) {
+    AssetPack pack;
+    if (!pack.open(path, error)) return false;
+    for (int page = 0;; ++page) {
+        const pack::Entry* e = pack.find(pack_atlas_name(page));
+        if (!e) break;
+        if (!pack.bytes(*e).data) {
+            if (error) *error = "corrupt atlas page in " + path;
+            return false;
+        }
+    }
+    TileMap map;
+    return load_level(pack, "level0", map, error);
+}
+
+// Decodes every entry, for comparison with loading every loose file.
+bool load_all_packed(const std::string& path, std::string* error) {
+    AssetPack pack;
+    if (!pack.open(path, error)) return false;
+    for (std::size_t i = 0; i < pack.entry_count(); ++i) {
+        if (!pack.bytes(pack.entry(i)).data) {
+            if (error) *error = "corrupt entry in " + path;
+            return false;
+        }
+    }
+    for (int i = 0; i < kLevels; ++i) {
+        TileMap map;
+        if (!load_level(pack, "level" + std::to_string(i), map, error)) return false;
+    }
+    for (int i = 0; i < kSounds; ++i) {
+        SoundClip clip;
+        if (!load_sound(pack, "sound" + std::to_string(i), clip, error)) return false;
+    }
+    return true;
+}
+
+bool load_all_loose(const Corpus& c, std::string* error) {
+    if (!startup_loose(c, error)) return false;
+    for (std::size_t i = 1; i < c.level_files.size(); ++i) {
+        TileMap map;
+        if (!load_level_text(c.level_files[i], map, error)) return false;
+    }
+    return true;
+}
+
+template <typename F>
+double best_ms(F&& f, bool& ok) {
+    double best = 1e30;
+    for (int r = 0; r < kRuns; ++r) {
+        const std::int64_t t0 = now_ns();
+        ok = f() && ok;
+        const double ms = static_cast<double>(now_ns() - t0) / 1e6;
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+} // namespace
+
+bool run_asset_suite(const Options& options, std::ostream& os) {
+    std::string error;
+    Corpus corpus;
+    if (!write_corpus(corpus, options.seed, &error)) {
+        os << error << "\n";
+        return false;
+    }
+    const std::string pack_path = (corpus.dir / "bench.pack").string();
+
+    PackBuildStats stats;
+    const std::int64_t t0 = now_ns();
+    if (!build_pack((corpus.dir / "manifest.txt").string(), pack_path, 1024, &stats, &error)) {
+        os << error << "\n";
+        return false;
+    }
+    const double build_ms = static_cast<double>(now_ns() - t0) / 1e6;
+
+    std::uintmax_t loose_bytes = 0;
+    for (const auto& f : {corpus.sprite_files, corpus.level_files, corpus.sound_files}) {
+        for (const std::string& path : f) loose_bytes += fs::file_size(path);
+    }
+
+    bool ok = true;
+    const double startup_loose_ms = best_ms([&] { return startup_loose(corpus, &error); }, ok);
+    const double startup_pack_ms = best_ms([&] { return startup_packed(pack_path, &error); }, ok);
+    const double all_loose_ms = best_ms([&] { return load_all_loose(corpus, &error); }, ok);
+    const double all_pack_ms = best_ms([&] { return load_all_packed(pack_path, &error); }, ok);
+    const double open_ms = best_ms([&] {
+        AssetPack pack;
+        return pack.open(pack_path, &error);
+    }, ok);
+
+    // Loose sources here are raw PAM/WAV, which decode at memcpy speed; PNG
+    // or Ogg sources would make the loose path considerably slower.
+    os << "corpus: " << stats.sprites << " sprites, " << stats.levels << " levels, " << stats.sounds
+       << " sounds; raw PAM/WAV sources, page cache warm, best of " << kRuns << "\n";
+    os << std::fixed << std::setprecision(3);
+    os << "loose files: " << loose_bytes / 1024 << " KiB in "
+       << corpus.sprite_files.size() + corpus.level_files.size() + corpus.sound_files.size() << " files\n";
+    os << "pack file:   " << fs::file_size(pack_path) / 1024 << " KiB, " << stats.atlas_pages
+       << " atlas page(s), built in " << build_ms << " ms, opened in " << open_ms << " ms\n";
+    os << std::left << std::setw(22) << "(ms)" << std::right << std::setw(10) << "loose" << std::setw(10)
+       << "pack" << std::setw(10) << "speedup\n";
+    os << std::left << std::setw(22) << "startup assets" << std::right << std::setw(10) << startup_loose_ms
+       << std::setw(10) << startup_pack_ms << std::setprecision(1) << std::setw(9)
+       << startup_loose_ms / startup_pack_ms << "x\n";
+    os << std::setprecision(3) << std::left << std::setw(22) << "decode everything" << std::right
+       << std::setw(10) << all_loose_ms << std::setw(10) << all_pack_ms << std::setprecision(1) << std::setw(9)
+       << all_loose_ms / all_pack_ms << "x\n";
+    os.unsetf(std::ios::floatfield);
+    if (!ok) os << error << "\n";
+
+    std::error_code ec;
+    fs::remove_all(corpus.dir, ec);
+    return ok;
+}
+
+} // namespace game::bench
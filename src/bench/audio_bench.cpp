@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio/audio_mixer.hpp"
+#include "bench/alloc_counter.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/cpu_features.hpp"
+#include "core/hash.hpp"
+#include "core/rng.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr std::uint32_t kRate = 48000;
+constexpr std::size_t kKernelFrames = 512;
+constexpr int kKernelCallbacks = 4000;
+
+// The threaded run: an audio thread mixing kCallbackFrames every callback
+// period while the game thread runs kGameFrames paced frames, triggering
+// sounds every frame and stalling for kSpike every kSpikeEvery frames.
+constexpr std::size_t kCallbackFrames = 256;
+constexpr auto kCallbackPeriod = std::chrono::microseconds(1000000 * kCallbackFrames / kRate);
+constexpr int kGameFrames = 1000;
+constexpr auto kGamePeriod = std::chrono::milliseconds(2);
+constexpr int kSpikeEvery = 50;
+constexpr auto kSpike = std::chrono::milliseconds(20);
+
+// Noise bursts with a decaying envelope, stereo and mono, each a quarter to
+// half a second long.
+std::vector<SoundClip> make_clips(std::uint32_t seed) {
+    Rng rng(seed);
+    std::vector<SoundClip> clips(8);
+    for (std::size_t c = 0; c < clips.size(); ++c) {
+        SoundClip& clip = clips[c];
+        clip.sample_rate = kRate;
+        clip.channels = c % 2 == 0 ? 2 : 1;
+        const int frames = rng.range(static_cast<int>(kRate / 4), static_cast<int>(kRate / 2));
+        for (int f = 0; f < frames; ++f) {
+            const float env = 1.0f - static_cast<float>(f) / static_cast<float>(frames);
+            for (std::uint32_t ch = 0; ch < clip.channels; ++ch) {
+                clip.samples.push_back(static_cast<std::int16_t>((rng.unit() * 2.0f - 1.0f) * 24000.0f * env));
+            }
+        }
+    }
+    return clips;
+}
+
+bool load_clips(AudioMixer& mixer, const std::vector<SoundClip>& clips, std::ostream& os) {
+    std::string error;
+    for (const SoundClip& clip : clips) {
+        if (mixer.add_clip(clip, &error) < 0) {
+            os << error << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Busy-waits, standing in for a frame that overruns.
+void stall(std::chrono::microseconds d) {
+    const auto end = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+struct Callbacks {
+    std::vector<double> mix_us;  // time inside the callback, waiting included
+    std::uint64_t late = 0;      // callbacks that took longer than their period
+    std::uint64_t commands_dropped = 0;
+};
+
+// Game thread and audio thread running side by side. With `locked`, both
+// sides share a mutex the way a device lock would be used: the callback
+// holds it for mix() and the game thread for its sound section, which on a
+// spike frame includes the stall (e.g. decoding a clip on first use).
+void run_threaded(const std::vector<SoundClip>& clips, bool locked, Callbacks& out) {
+    AudioMixer mixer(kRate);
+    std::string error;
+    for (const SoundClip& clip : clips) mixer.add_clip(clip, &error);
+    std::mutex device;
+    std::atomic<bool> stop{false};
+    out.mix_us.reserve(static_cast<std::size_t>(kGameFrames) * 8);
+
+    std::thread audio([&] {
+        std::vector<std::int16_t> buffer(kCallbackFrames * AudioMixer::kChannels);
+        auto next = std::chrono::steady_clock::now();
+        while (!stop.load(std::memory_order_relaxed)) {
+            next += kCallbackPeriod;
+            std::this_thread::sleep_until(next);
+            const std::int64_t t0 = now_ns();
+            if (locked) {
+                std::lock_guard<std::mutex> lock(device);
+                mixer.mix(buffer.data(), kCallbackFrames);
+            } else {
+                mixer.mix(buffer.data(), kCallbackFrames);
+            }
+            const std::int64_t t1 = now_ns();
+            out.mix_us.push_back(static_cast<double>(t1 - t0) / 1000.0);
+            if (std::chrono::nanoseconds(t1 - t0) > kCallbackPeriod) ++out.late;
+        }
+    });
+
+    Rng rng(7);
+    VoiceId last = 0;
+    auto next = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kGameFrames; ++frame) {
+        const bool spike = frame % kSpikeEvery == kSpikeEvery - 1;
+        {
+            std::unique_lock<std::mutex> lock(device, std::defer_lock);
+            if (locked) lock.lock();
+            if (spike) stall(kSpike);
+            mixer.set_volume(last, rng.unit(), rng.unit() * 2.0f - 1.0f);
+            last = mixer.play(rng.range(0, static_cast<int>(clips.size()) - 1), 0.25f, rng.unit() * 2.0f - 1.0f);
+        }
+        next += kGamePeriod;
+        std::this_thread::sleep_until(next);
+    }
+    stop.store(true);
+    audio.join();
+    out.commands_dropped = mixer.commands_dropped();
+}
+
+} // namespace
+
+bool run_audio_suite(const Options& options, std::ostream& os) {
+    const std::vector<SoundClip> clips = make_clips(options.seed);
+    const SimdLevel best = active_simd_level();
+    std::vector<SimdLevel> levels{SimdLevel::Scalar};
+    if (best != SimdLevel::Scalar) levels.push_back(SimdLevel::Sse2);
+    if (best == SimdLevel::Avx2) levels.push_back(SimdLevel::Avx2);
+
+    // Mixing cost with every voice busy, and the same output on every path.
+    const double budget_us = 1e6 * static_cast<double>(kKernelFrames) / kRate;
+    os << "cpu: " << simd_level_name(best) << "  " << AudioMixer::kMaxVoices << " voices, " << kKernelFrames
+       << " frames per callback (" << std::fixed << std::setprecision(2) << budget_us / 1000.0 << " ms of audio)\n";
+    os.unsetf(std::ios::floatfield);
+    os << std::left << std::setw(10) << "path" << std::right << std::setw(14) << "us/callback" << std::setw(12)
+       << "% budget" << std::setw(14) << "heap allocs" << "\n";
+    bool ok = true;
+    std::uint64_t reference = 0;
+    for (SimdLevel level : levels) {
+        AudioMixer mixer(kRate, level);
+        if (!load_clips(mixer, clips, os)) return false;
+        for (int v = 0; v < AudioMixer::kMaxVoices; ++v) {
+            const float pan = static_cast<float>(v) / (AudioMixer::kMaxVoices - 1) * 2.0f - 1.0f;
+            mixer.play(v % static_cast<int>(clips.size()), 0.2f, pan, true);
+        }
+        std::vector<std::int16_t> out(kKernelFrames * AudioMixer::kChannels);
+        std::uint64_t h = kFnv1aOffset;
+        const std::uint64_t allocs_before = allocation_count();
+        const std::int64_t t0 = now_ns();
+        for (int c = 0; c < kKernelCallbacks; ++c) {
+            mixer.mix(out.data(), kKernelFrames);
+            h = fnv1a64(out.data(), out.size() * sizeof(std::int16_t), h);
+        }
+        const double us = static_cast<double>(now_ns() - t0) / 1000.0 / kKernelCallbacks;
+        const std::uint64_t allocs = allocation_count() - allocs_before;
+        os << std::left << std::setw(10) << simd_level_name(level) << std::right << std::fixed << std::setprecision(2)
+           << std::setw(14) << us << std::setw(12) << 100.0 * us / budget_us << std::setw(14) << allocs << "\n";
+        os.unsetf(std::ios::floatfield);
+
+        if (level == SimdLevel::Scalar) reference = h;
+        if (h != reference) {
+            os << simd_level_name(level) << " output differs from scalar\n";
+            ok = false;
+        }
+        if (allocs != 0 || mixer.active_voices() != AudioMixer::kMaxVoices) ok = false;
+    }
+
+    // Callback times while the game thread triggers sounds and spikes.
+    os << "\n" << kGameFrames << " game frames, " << kSpike.count() << " ms stall every " << kSpikeEvery
+       << ", callback every " << kCallbackPeriod.count() << " us\n";
+    Callbacks lock_free, mutex;
+    run_threaded(clips, false, lock_free);
+    run_threaded(clips, true, mutex);
+    os << "late callbacks: lock-free " << lock_free.late << " of " << lock_free.mix_us.size() << ", mutex "
+       << mutex.late << " of " << mutex.mix_us.size() << "; commands dropped: " << lock_free.commands_dropped
+       << "\n";
+    PercentileTable table(os);
+    table.row("lock-free", lock_free.mix_us);
+    table.row("mutex", mutex.mix_us);
+    return ok && lock_free.commands_dropped == 0;
+}
+
+} // namespace game::bench
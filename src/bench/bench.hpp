@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/stats.hpp"
+
+namespace game::bench {
+
+struct Options {
+    int frames = 20000;
+    std::uint32_t seed = 1;
+    int level_width = 512;
+    int level_height = 64;
+    int actors = 20000;
+    int threads = 0;  // most threads the jobs suite scales to; 0 = hardware threads
+};
+
+// Fixed-width table of timing percentiles, one row per stage. Values are in
+// microseconds.
+class PercentileTable {
+public:
+    explicit PercentileTable(std::ostream& os);
+    void row(const std::string& label, std::vector<double>& samples_us);
+
+private:
+    std::ostream& os_;
+};
+
+// Each suite writes its own section of bench_output.txt and returns false if
+// one of its checks failed, which makes the harness exit non-zero.
+struct Suite {
+    const char* name;
+    bool (*run)(const Options& options, std::ostream& os);
+};
+
+// Simulates options.frames headless frames of a scripted level and reports
+// per-stage timing percentiles, then times the collision stage with tile
+// sweeps on every SIMD level and fails if their states differ.
+bool run_frame_suite(const Options& options, std::ostream& os);
+
+// Counts overlapping actor pairs with the spatial grid and with an O(n^2)
+// scan at 1k, 10k and 100k actors, checking both agree.
+bool run_broadphase_suite(const Options& options, std::ostream& os);
+
+// Times the swept-AABB kernel on every SIMD level this CPU supports and
+// checks each produces contacts bit-identical to the scalar path.
+bool run_sweep_suite(const Options& options, std::ostream& os);
+
+// Loads a synthetic asset set from loose files and from an asset pack and
+// compares the time to have everything decoded.
+bool run_asset_suite(const Options& options, std::ostream& os);
+
+// Records a ten-minute scripted session, round-trips it through a replay
+// file and replays it uncapped, checking every state checksum matches.
+bool run_replay_suite(const Options& options, std::ostream& os);
+
+// Times the update and render-prep stages of a particle-heavy scene on the
+// job system at 1..N threads and checks every thread count simulates the
+// exact same world.
+bool run_jobs_suite(const Options& options, std::ostream& os);
+
+// Pans across a large level drawing its tiles once as per-tile sprites and
+// once as cached chunks, and compares tiles drawn per frame.
+bool run_tiles_suite(const Options& options, std::ostream& os);
+
+// Crosses small and large levels streamed through a LevelStreamer and fully
+// loaded, comparing memory growth and frame times.
+bool run_stream_suite(const Options& options, std::ostream& os);
+
+// Times the audio mixer on every SIMD level with all voices busy, checking
+// the output matches and nothing allocates, then compares callback times
+// while a spiking game thread sends commands lock-free and under a mutex.
+bool run_audio_suite(const Options& options, std::ostream& os);
+
+// Captures a rewind snapshot every tick at 1k and 10k actors, timing capture
+// and restore, and checks a rollback re-simulates to the identical state and
+// that a ring which wraps on snapshots of varying size restores every tick.
+bool run_rewind_suite(const Options& options, std::ostream& os);
+
+// Runs the shared actor physics on the same actors in float and in 16.16
+// fixed point, reporting the fixed-point cost relative to float, and checks
+// the fixed-point state repeats exactly.
+bool run_fixed_suite(const Options& options, std::ostream& os);
+
+// Pans across levels of 1k, 10k and 100k actors timing render prep with
+// grid culling and radix-sorted batching, checking the grid finds what a
+// linear scan does, then times the radix key sort against std::sort.
+bool run_cull_suite(const Options& options, std::ostream& os);
+
+// Keeps 100k particles alive from batched emitters, timing emission, SIMD
+// integration and single-batch render prep per tick against a 4 ms budget
+// on every SIMD level, and checks each level and the old struct-per-particle
+// layout simulate identical state without allocating.
+bool run_particle_suite(const Options& options, std::ostream& os);
+
+} // namespace game::bench
@@ -0,0 +1,148 @@
+// Headless benchmark harness. Runs the simulation without SDL and writes
+// per-suite timing reports to bench_output.txt (and stdout).
+//
+//   sdl_game_bench [--frames N] [--seed S] [--level WxH] [--actors N] [--threads N] [--out PATH]
+//                  [--trace PATH] [suite...]
+//
+// --trace also writes the profiler's history as a Chrome trace once the
+// suites finish, covering the last frames each thread recorded.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "core/profiler.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+PercentileTable::PercentileTable(std::ostream& os) : os_(os) {
+    os_ << std::left << std::setw(14) << "stage (us)" << std::right << std::setw(10) << "mean"
+        << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+        << std::setw(10) << "max" << "\n";
+}
+
+void PercentileTable::row(const std::string& label, std::vector<double>& samples_us) {
+    const Percentiles p = summarize(samples_us);
+    os_ << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(3)
+        << std::setw(10) << p.mean << std::setw(10) << p.p50 << std::setw(10) << p.p90
+        << std::setw(10) << p.p99 << std::setw(10) << p.max << "\n";
+    os_.unsetf(std::ios::floatfield);
+}
+
+} // namespace game::bench
+
+namespace {
+
+const game::bench::Suite kSuites[] = {
+    {"frame", game::bench::run_frame_suite},
+    {"broadphase", game::bench::run_broadphase_suite},
+    {"sweep", game::bench::run_sweep_suite},
+    {"assets", game::bench::run_asset_suite},
+    {"replay", game::bench::run_replay_suite},
+    {"jobs", game::bench::run_jobs_suite},
+    {"tiles", game::bench::run_tiles_suite},
+    {"stream", game::bench::run_stream_suite},
+    {"audio", game::bench::run_audio_suite},
+    {"rewind", game::bench::run_rewind_suite},
+    {"fixed", game::bench::run_fixed_suite},
+    {"cull", game::bench::run_cull_suite},
+    {"particles", game::bench::run_particle_suite},
+};
+
+void usage() {
+    std::fprintf(stderr, "usage: sdl_game_bench [--frames N] [--seed S] [--level WxH] [--actors N] [--threads N] "
+                         "[--out PATH] [--trace PATH] [suite...]\n");
+    std::fprintf(stderr, "suites:");
+    for (const auto& s : kSuites) std::fprintf(stderr, " %s", s.name);
+    std::fprintf(stderr, "\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    game::bench::Options options;
+    std::string out_path = "bench_output.txt";
+    std::string trace_path;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--frames") == 0 && has_value) {
+            options.frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && has_value) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--level") == 0 && has_value) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.level_width, &options.level_height) != 2) {
+                usage();
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--actors") == 0 && has_value) {
+            options.actors = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--out") == 0 && has_value) {
+            out_path = argv[++i];
+        } else if (std::strcmp(arg, "--trace") == 0 && has_value) {
+            trace_path = argv[++i];
+        } else if (arg[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            selected.emplace_back(arg);
+        }
+    }
+    if (options.frames <= 0 || options.actors < 0 || options.threads < 0 || options.level_width < 8 || options.level_height < 8) {
+        usage();
+        return 2;
+    }
+    if (options.level_width > game::World::kMaxLevelTiles || options.level_height > game::World::kMaxLevelTiles) {
+        std::fprintf(stderr, "--level: this build's physics handles at most %d tiles a side\n",
+                     game::World::kMaxLevelTiles);
+        return 2;
+    }
+
+    game::profile::set_thread_name("main");
+    std::ostringstream report;
+    bool ran_any = false;
+    bool passed = true;
+    for (const auto& suite : kSuites) {
+        bool wanted = selected.empty();
+        for (const std::string& name : selected) wanted = wanted || name == suite.name;
+        if (!wanted) continue;
+        report << "== " << suite.name << " ==\n";
+        if (!suite.run(options, report)) {
+            report << "FAILED\n";
+            passed = false;
+        }
+        report << "\n";
+        ran_any = true;
+    }
+    if (!ran_any) {
+        usage();
+        return 2;
+    }
+
+    std::cout << report.str();
+    std::ofstream out(out_path);
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", out_path.c_str());
+        return 1;
+    }
+    out << report.str();
+
+    std::string error;
+    if (!trace_path.empty() && !game::profile::write_chrome_trace(trace_path, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    return passed ? 0 : 1;
+}
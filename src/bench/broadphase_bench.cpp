@@ -0,0 +1,99 @@
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/rng.hpp"
+#include "sim/spatial_grid.hpp"
+
+namespace game::bench {
+
+namespace {
+
+struct Boxes {
+    std::vector<float> x, y, w, h;
+};
+
+// Random actor-sized boxes at a fixed density, so every size sees the same
+// number of neighbours per actor.
+Boxes make_boxes(std::size_t n, float side, std::uint32_t seed) {
+    Rng rng(seed);
+    Boxes b;
+    b.x.resize(n);
+    b.y.resize(n);
+    b.w.resize(n);
+    b.h.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        b.w[i] = 4.0f + 12.0f * rng.unit();
+        b.h[i] = 4.0f + 12.0f * rng.unit();
+        b.x[i] = (side - b.w[i]) * rng.unit();
+        b.y[i] = (side - b.h[i]) * rng.unit();
+    }
+    return b;
+}
+
+bool overlap(const Boxes& b, std::size_t i, std::size_t j) {
+    return b.x[i] < b.x[j] + b.w[j] && b.x[j] < b.x[i] + b.w[i] && b.y[i] < b.y[j] + b.h[j] &&
+           b.y[j] < b.y[i] + b.h[i];
+}
+
+std::uint64_t brute_force_pairs(const Boxes& b) {
+    const std::size_t n = b.x.size();
+    std::uint64_t pairs = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) pairs += overlap(b, i, j) ? 1 : 0;
+    }
+    return pairs;
+}
+
+std::uint64_t grid_pairs(SpatialGrid& grid, const Boxes& b) {
+    const std::size_t n = b.x.size();
+    grid.build(b.x.data(), b.y.data(), b.w.data(), b.h.data(), n);
+    std::uint64_t pairs = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        grid.query({b.x[i], b.y[i], b.w[i], b.h[i]}, [&](std::uint32_t j) {
+            if (j > i && overlap(b, i, j)) ++pairs;
+        });
+    }
+    return pairs;
+}
+
+} // namespace
+
+bool run_broadphase_suite(const Options& options, std::ostream& os) {
+    constexpr float kAreaPerActor = 2048.0f;  // px^2
+    constexpr float kCellSize = 64.0f;
+    bool ok = true;
+
+    os << std::left << std::setw(10) << "actors" << std::right << std::setw(12) << "pairs"
+       << std::setw(16) << "brute (ms)" << std::setw(16) << "grid (ms)" << std::setw(12) << "speedup"
+       << "\n";
+    for (std::size_t n : {std::size_t{1000}, std::size_t{10000}, std::size_t{100000}}) {
+        const float side = std::sqrt(kAreaPerActor * static_cast<float>(n));
+        const Boxes boxes = make_boxes(n, side, options.seed);
+
+        SpatialGrid grid;
+        grid.reset(side, side, kCellSize);
+
+        std::int64_t t0 = now_ns();
+        const std::uint64_t brute = brute_force_pairs(boxes);
+        const double brute_ms = static_cast<double>(now_ns() - t0) / 1e6;
+
+        t0 = now_ns();
+        const std::uint64_t gridded = grid_pairs(grid, boxes);
+        const double grid_ms = static_cast<double>(now_ns() - t0) / 1e6;
+
+        os << std::left << std::setw(10) << n << std::right << std::setw(12) << gridded << std::fixed
+           << std::setprecision(3) << std::setw(16) << brute_ms << std::setw(16) << grid_ms
+           << std::setprecision(1) << std::setw(11) << brute_ms / grid_ms << "x\n";
+        os.unsetf(std::ios::floatfield);
+        if (brute != gridded) {
+            os << "pair count mismatch: brute force found " << brute << "\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+} // namespace game::bench
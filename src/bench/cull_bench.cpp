@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+#include "bench/alloc_counter.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/frame_arena.hpp"
+#include "core/radix_sort.hpp"
+#include "core/rng.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "sim/levels.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr float kViewWidth = 640.0f;
+constexpr float kViewHeight = 360.0f;
+constexpr float kPanSpeed = 6.0f;  // pixels per frame
+constexpr int kMaxFrames = 600;
+// Render prep (cull, sort, batch) should fit this at any actor count.
+constexpr double kPrepBudgetUs = 500.0;
+// Keys sorted per size in the sort comparison, as many distinct sets as that
+// takes, so the branch predictor cannot learn one small input.
+constexpr std::size_t kSortKeysPerSize = 1u << 21;
+
+// What culling cost before the grid: every actor tested against the view.
+std::size_t scan_visible(const ActorStore& actors, const Aabb& view) {
+    std::size_t visible = 0;
+    for (std::uint32_t i = 0; i < actors.size(); ++i) visible += overlaps(actors.bounds(i), view) ? 1 : 0;
+    return visible;
+}
+
+// Keys shaped like the sprite batcher's: a few layers, two atlas pages, a
+// spread of screen rows and the submission index.
+std::vector<std::uint64_t> make_keys(std::size_t n, std::uint32_t seed) {
+    Rng rng(seed);
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto layer = static_cast<std::uint64_t>(rng.range(1, 3));
+        const auto atlas = static_cast<std::uint64_t>(rng.range(0, 1));
+        const auto y = static_cast<std::uint64_t>(rng.next() & 0xffffffu);
+        keys[i] = layer << 56 | atlas << 40 | y << 16 | (i & 0xffff);
+    }
+    return keys;
+}
+
+double ns_per_key(std::int64_t ns, std::size_t keys) { return static_cast<double>(ns) / static_cast<double>(keys); }
+
+} // namespace
+
+bool run_cull_suite(const Options& options, std::ostream& os) {
+    const int frames = std::min(options.frames, kMaxFrames);
+    const SpriteRegistry sprites = make_builtin_sprites();
+    RenderList list;
+    list.cache_tiles = true;  // tiles as chunk quads, so the sprites are all actors
+    SpriteBatcher batcher;
+    FrameArena arena;
+    bool ok = true;
+
+    os << "render prep (grid cull + radix sort + batch) over " << frames << " frames panning a "
+       << options.level_width << "x" << options.level_height << " level, budget " << kPrepBudgetUs << " us\n";
+    for (const int actors : {1000, 10000, 100000}) {
+        World world(make_generated_level(options.level_width, options.level_height, options.seed), {32.0f, 32.0f});
+        populate_actors(world, actors, options.seed);
+        const float level_w = static_cast<float>(world.map().width() * TileMap::kTileSize);
+        const float level_h = static_cast<float>(world.map().height() * TileMap::kTileSize);
+
+        std::vector<double> prep_us, scan_us;
+        prep_us.reserve(static_cast<std::size_t>(frames));
+        scan_us.reserve(static_cast<std::size_t>(frames));
+        std::size_t visible = 0;
+        int over_budget = 0;
+        bool matched = true;
+        for (int frame = 0; frame < frames; ++frame) {
+            const float t = static_cast<float>(frame);
+            const Vec2 target{std::fmod(t * kPanSpeed, level_w),
+                              level_h * 0.5f + (level_h * 0.5f - kViewHeight) * std::sin(t * 0.01f)};
+            const Camera camera = Camera::follow(target, kViewWidth, kViewHeight, world.map());
+
+            const std::int64_t t0 = now_ns();
+            build_render_list(world, 1.0f, camera, sprites, list);
+            batcher.build(list, arena);
+            const std::int64_t t1 = now_ns();
+            const std::size_t scanned = scan_visible(world.actors(), camera.view());
+            const std::int64_t t2 = now_ns();
+            arena.reset();
+
+            prep_us.push_back(static_cast<double>(t1 - t0) / 1000.0);
+            scan_us.push_back(static_cast<double>(t2 - t1) / 1000.0);
+            over_budget += prep_us.back() > kPrepBudgetUs ? 1 : 0;
+            visible += list.sprites.size();
+            matched = matched && list.sprites.size() == scanned && list.sprites.dropped() == 0;
+        }
+        ok = ok && matched;
+        os << "\n" << world.actors().size() << " actors, " << visible / static_cast<std::size_t>(frames)
+           << " visible per frame; grid culling " << (matched ? "matched" : "DIFFERED from")
+           << " the linear scan; " << over_budget << " frames over budget\n";
+        PercentileTable table(os);
+        table.row("render prep", prep_us);
+        table.row("linear scan", scan_us);
+    }
+
+    // The batcher's key sort against std::sort on the same keys, up to the
+    // batcher's sprite limit.
+    os << "\n" << std::left << std::setw(10) << "keys" << std::right << std::setw(14) << "std::sort" << std::setw(14)
+       << "radix" << std::setw(10) << "speedup" << std::setw(14) << "radix allocs" << "   (ns/key)\n";
+    for (const std::size_t n : {std::size_t{256}, std::size_t{1024}, std::size_t{4096}, SpriteBatcher::kMaxSprites}) {
+        const std::size_t sets = kSortKeysPerSize / n;
+        const std::vector<std::uint64_t> keys = make_keys(kSortKeysPerSize, options.seed);
+        std::vector<std::uint64_t> by_std(keys), by_radix(keys), scratch(n);
+
+        const std::int64_t t0 = now_ns();
+        for (std::size_t s = 0; s < sets; ++s) std::sort(&by_std[s * n], &by_std[s * n] + n);
+        const std::int64_t std_ns = now_ns() - t0;
+        const std::uint64_t allocs_before = allocation_count();
+        const std::int64_t t1 = now_ns();
+        for (std::size_t s = 0; s < sets; ++s) radix_sort(&by_radix[s * n], scratch.data(), n);
+        const std::int64_t radix_ns = now_ns() - t1;
+        const std::uint64_t allocs = allocation_count() - allocs_before;
+
+        const std::size_t sorted = n * sets;
+        os << std::left << std::setw(10) << n << std::right << std::fixed << std::setprecision(2) << std::setw(14)
+           << ns_per_key(std_ns, sorted) << std::setw(14) << ns_per_key(radix_ns, sorted) << std::setw(9)
+           << static_cast<double>(std_ns) / static_cast<double>(radix_ns) << "x" << std::setw(14) << allocs;
+        os.unsetf(std::ios::floatfield);
+        if (by_radix != by_std) {
+            os << "   radix order differs";
+            ok = false;
+        }
+        os << "\n";
+        ok = ok && allocs == 0;
+    }
+    return ok;
+}
+
+} // namespace game::bench
@@ -0,0 +1,139 @@
+#include <cmath>
+#include <iomanip>
+#include <type_traits>
+#include <vector>
+
+#include "bench/alloc_counter.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/cpu_features.hpp"
+#include "core/hash.hpp"
+#include "sim/levels.hpp"
+#include "sim/physics.hpp"
+#include "sim/tile_sweep.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr int kTicks = 600;
+constexpr float kDt = 1.0f / 120.0f;
+// World's gravity tuning.
+constexpr float kGravity = 1800.0f;
+constexpr float kMaxFallSpeed = 900.0f;
+
+// Copy of a populated level's actors in number type T.
+template <typename T>
+struct Bodies {
+    std::vector<T> x, y, w, h, vel_x, vel_y;
+    std::vector<std::uint8_t> flags, blocked;
+
+    explicit Bodies(const ActorStore& actors) {
+        const std::size_t n = actors.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            x.push_back(T(to_float(actors.x[i])));
+            y.push_back(T(to_float(actors.y[i])));
+            w.push_back(T(to_float(actors.w[i])));
+            h.push_back(T(to_float(actors.h[i])));
+            vel_x.push_back(T(to_float(actors.vel_x[i])));
+            vel_y.push_back(T(to_float(actors.vel_y[i])));
+        }
+        flags.assign(actors.flags.begin(), actors.flags.end());
+        blocked.resize(n);
+    }
+
+    std::uint64_t hash() const {
+        std::uint64_t h = fnv1a64(x.data(), x.size() * sizeof(T));
+        h = fnv1a64(y.data(), y.size() * sizeof(T), h);
+        h = fnv1a64(vel_x.data(), vel_x.size() * sizeof(T), h);
+        return fnv1a64(vel_y.data(), vel_y.size() * sizeof(T), h);
+    }
+};
+
+// World's movement without the gameplay around it: gravity, then a tile
+// sweep per axis, bouncing off walls and stopping on floors and ceilings.
+template <typename T>
+void step(const TileMap& map, Bodies<T>& b) {
+    const auto n = static_cast<std::uint32_t>(b.x.size());
+    const T dt(kDt);
+    apply_gravity(b.vel_y.data(), b.flags.data(), 0, n, T(kGravity * kDt), T(kMaxFallSpeed));
+    const SweepBodies<T> s{b.x.data(),     b.y.data(),     b.w.data(), b.h.data(),
+                           b.vel_x.data(), b.vel_y.data(), b.blocked.data()};
+    sweep_actors(map, s, 0, n, dt, active_simd_level());
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (b.blocked[i] & kBlockedX) b.vel_x[i] = -b.vel_x[i];
+        if (b.blocked[i] & kBlockedY) b.vel_y[i] = T();
+    }
+}
+
+struct Run {
+    std::vector<double> tick_us;
+    std::uint64_t allocations = 0;
+    std::uint64_t hash = 0;
+};
+
+template <typename T>
+Run run(const TileMap& map, Bodies<T>& b) {
+    Run r;
+    r.tick_us.reserve(kTicks);
+    step(map, b);  // warm-up: sizes the contact arrays
+    const std::uint64_t allocs_before = allocation_count();
+    for (int t = 0; t < kTicks; ++t) {
+        const std::int64_t t0 = now_ns();
+        step(map, b);
+        r.tick_us.push_back(static_cast<double>(now_ns() - t0) / 1000.0);
+    }
+    r.allocations = allocation_count() - allocs_before;
+    r.hash = b.hash();
+    return r;
+}
+
+double mean(const std::vector<double>& v) {
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    return v.empty() ? 0.0 : sum / static_cast<double>(v.size());
+}
+
+} // namespace
+
+bool run_fixed_suite(const Options& options, std::ostream& os) {
+    World world(make_generated_level(options.level_width, options.level_height, options.seed), {32.0f, 32.0f});
+    populate_actors(world, options.actors, options.seed);
+
+    Bodies<float> floats(world.actors());
+    Bodies<Fixed> fixeds(world.actors());
+    Run float_run = run(world.map(), floats);
+    Run fixed_run = run(world.map(), fixeds);
+    // The fixed-point state has to come out the same on a second pass; its
+    // hash is the number to compare between machines and compilers.
+    Bodies<Fixed> again(world.actors());
+    const bool repeated = run(world.map(), again).hash == fixed_run.hash;
+
+    // The number types round differently, so trajectories drift apart;
+    // walkers that turn at a wall a tick earlier end up far away.
+    std::size_t close = 0;
+    for (std::size_t i = 0; i < floats.x.size(); ++i) {
+        const bool near_x = std::fabs(to_float(fixeds.x[i]) - floats.x[i]) <= 1.0f;
+        close += near_x && std::fabs(to_float(fixeds.y[i]) - floats.y[i]) <= 1.0f ? 1 : 0;
+    }
+
+    os << "world physics in this build: " << (std::is_same<Real, Fixed>::value ? "16.16 fixed point" : "float")
+       << "\n";
+    os << floats.x.size() << " actors, " << kTicks << " ticks of gravity and tile sweeps; float sweeps on "
+       << simd_level_name(active_simd_level()) << ", fixed point on scalar integers\n";
+    os << "fixed/float time per tick: " << std::fixed << std::setprecision(2)
+       << mean(fixed_run.tick_us) / mean(float_run.tick_us) << "x\n";
+    os << "actors within 1 px of their float position: "
+       << 100.0 * static_cast<double>(close) / static_cast<double>(floats.x.size()) << "%\n";
+    os.unsetf(std::ios::floatfield);
+    os << "state hash: float " << std::hex << float_run.hash << ", fixed " << fixed_run.hash << std::dec
+       << (repeated ? " (repeated)" : " (DIFFERED on a second run)") << "\n";
+    os << "heap allocations: " << float_run.allocations << " float, " << fixed_run.allocations << " fixed\n";
+    PercentileTable table(os);
+    table.row("float", float_run.tick_us);
+    table.row("fixed", fixed_run.tick_us);
+    return repeated && float_run.allocations == 0 && fixed_run.allocations == 0;
+}
+
+} // namespace game::bench
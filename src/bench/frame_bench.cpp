@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include "bench/alloc_counter.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/cpu_features.hpp"
+#include "core/frame_arena.hpp"
+#include "core/profiler.hpp"
+#include "core/stats.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "sim/input_script.hpp"
+#include "sim/levels.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr float kDt = 1.0f / 120.0f;
+constexpr float kViewWidth = 640.0f;
+constexpr float kViewHeight = 360.0f;
+// Frames allowed to size the pools, arena and scratch buffers before heap
+// allocations in the update and render stages count as failures.
+constexpr int kWarmupFrames = 120;
+// Empty scopes timed to report what one profiling marker costs.
+constexpr int kMarkerSamples = 1'000'000;
+// Frames collide() is timed with tile sweeps on each SIMD level.
+constexpr int kSweepCompareFrames = 600;
+
+double us_since(std::int64_t start_ns, std::int64_t end_ns) {
+    return static_cast<double>(end_ns - start_ns) / 1000.0;
+}
+
+// Mean cost of an empty GAME_PROFILE_SCOPE in nanoseconds, including the
+// two clock reads it makes. The samples are discarded so they do not crowd
+// the frames out of a --trace.
+double marker_cost_ns() {
+    const std::int64_t start = now_ns();
+    for (int i = 0; i < kMarkerSamples; ++i) {
+        GAME_PROFILE_SCOPE("marker");
+    }
+    const std::int64_t end = now_ns();
+    profile::discard_thread_events();
+    return static_cast<double>(end - start) / kMarkerSamples;
+}
+
+// Runs the same frames in one world per SIMD level, timing collide() on
+// each in turn. Prints the p50s and fails only if the states differ.
+bool compare_tile_sweeps(const Options& options, std::ostream& os) {
+    const SimdLevel best = active_simd_level();
+    std::vector<SimdLevel> levels{SimdLevel::Scalar};
+    if (best != SimdLevel::Scalar) levels.push_back(SimdLevel::Sse2);
+    if (best == SimdLevel::Avx2) levels.push_back(SimdLevel::Avx2);
+    const TileMap map = make_generated_level(options.level_width, options.level_height, options.seed);
+    std::vector<World> worlds;
+    worlds.reserve(levels.size());
+    for (SimdLevel level : levels) {
+        worlds.emplace_back(map, Vec2{32.0f, 32.0f});
+        worlds.back().set_simd_level(level);
+        populate_actors(worlds.back(), options.actors, options.seed);
+    }
+    InputScript script(options.seed);
+    const int frames = std::min(options.frames, kSweepCompareFrames);
+    std::vector<std::vector<double>> samples(levels.size());
+    for (std::vector<double>& s : samples) s.reserve(static_cast<std::size_t>(frames));
+    for (int frame = 0; frame < frames; ++frame) {
+        for (std::size_t w = 0; w < worlds.size(); ++w) {
+            World& world = worlds[w];
+            world.apply_input(script.at(world.tick()), kDt);
+            world.integrate(kDt);
+            const std::int64_t t0 = now_ns();
+            world.collide(kDt);
+            samples[w].push_back(us_since(t0, now_ns()));
+        }
+    }
+    bool matched = true;
+    os << "collision p50 over " << frames << " frames, tile sweeps on" << std::fixed << std::setprecision(1);
+    for (std::size_t w = 0; w < worlds.size(); ++w) {
+        os << (w ? ", " : " ") << simd_level_name(levels[w]) << " " << summarize(samples[w]).p50 << " us";
+        if (worlds[w].checksum() != worlds[0].checksum()) {
+            os << " (state DIFFERS)";
+            matched = false;
+        }
+    }
+    os.unsetf(std::ios::floatfield);
+    if (!matched) os << " FAIL";
+    os << "\n";
+    return matched;
+}
+
+} // namespace
+
+bool run_frame_suite(const Options& options, std::ostream& os) {
+    const double marker_ns = profile::kEnabled ? marker_cost_ns() : 0.0;
+    World world(make_generated_level(options.level_width, options.level_height, options.seed),
+                {32.0f, 32.0f});
+    populate_actors(world, options.actors, options.seed);
+    InputScript script(options.seed);
+    const SpriteRegistry sprites = make_builtin_sprites();
+    RenderList list;
+    SpriteBatcher batcher;
+    FrameArena arena;
+
+    const std::size_t n = static_cast<std::size_t>(options.frames);
+    std::vector<double> input_us, physics_us, collision_us, render_us, frame_us;
+    input_us.reserve(n);
+    physics_us.reserve(n);
+    collision_us.reserve(n);
+    render_us.reserve(n);
+    frame_us.reserve(n);
+
+    std::uint64_t sprite_total = 0;
+    std::uint64_t batch_total = 0;
+    std::uint64_t steady_allocations = 0;
+    int first_allocating_frame = -1;
+    for (int frame = 0; frame < options.frames; ++frame) {
+        const std::uint64_t allocs_before = allocation_count();
+        const std::int64_t t0 = now_ns();
+        world.apply_input(script.at(world.tick()), kDt);
+        const std::int64_t t1 = now_ns();
+        world.integrate(kDt);
+        const std::int64_t t2 = now_ns();
+        world.collide(kDt);
+        const std::int64_t t3 = now_ns();
+        const Camera camera = Camera::follow(world.player_pos(), kViewWidth, kViewHeight, world.map());
+        {
+            GAME_PROFILE_SCOPE("render-prep");
+            build_render_list(world, 1.0f, camera, sprites, list);
+            batcher.build(list, arena);
+        }
+        const std::int64_t t4 = now_ns();
+        const std::uint64_t allocs = allocation_count() - allocs_before;
+        if (frame >= kWarmupFrames && allocs > 0) {
+            steady_allocations += allocs;
+            if (first_allocating_frame < 0) first_allocating_frame = frame;
+        }
+
+        sprite_total += batcher.stats().sprites;
+        batch_total += batcher.stats().batches;
+        arena.reset();
+        input_us.push_back(us_since(t0, t1));
+        physics_us.push_back(us_since(t1, t2));
+        collision_us.push_back(us_since(t2, t3));
+        render_us.push_back(us_since(t3, t4));
+        frame_us.push_back(us_since(t0, t4));
+    }
+
+    os << "frames: " << options.frames << "  level: " << options.level_width << "x"
+       << options.level_height << "  actors: " << options.actors << "  seed: " << options.seed << "\n";
+    os << "final player pos: " << world.player_pos().x << ", " << world.player_pos().y
+       << "  live actors: " << world.actors().size() << "\n";
+    os << "sprites/frame: " << (n ? sprite_total / n : 0) << "  batches/frame: " << (n ? batch_total / n : 0)
+       << "\n";
+    os << "heap allocations in update/render after " << kWarmupFrames << " warm-up frames: " << steady_allocations;
+    if (first_allocating_frame >= 0) os << " (first in frame " << first_allocating_frame << ") FAIL";
+    os << "\n";
+    if (profile::kEnabled) {
+        os << "profiling markers: " << marker_ns << " ns per scope\n";
+    } else {
+        os << "profiling markers: compiled out (release-lite)\n";
+    }
+    PercentileTable table(os);
+    table.row("input", input_us);
+    table.row("physics", physics_us);
+    table.row("collision", collision_us);
+    table.row("render-prep", render_us);
+    table.row("frame", frame_us);
+    const bool sweeps_ok = compare_tile_sweeps(options, os);
+    return steady_allocations == 0 && sweeps_ok;
+}
+
+} // namespace game::bench
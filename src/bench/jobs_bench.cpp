@@ -0,0 +1,116 @@
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/frame_arena.hpp"
+#include "core/job_system.hpp"
+#include "core/rng.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "sim/input_script.hpp"
+#include "sim/levels.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr float kDt = 1.0f / 120.0f;
+constexpr int kMaxFrames = 2000;
+// Particles kept alive on top of the actors: bursts are emitted every tick
+// to replace the ones that expire.
+constexpr std::size_t kParticles = 200000;
+constexpr int kBurstSize = 64;
+constexpr int kBurstsPerTick = 80;
+
+struct ThreadRun {
+    int threads = 0;
+    std::vector<double> update_us;
+    std::vector<double> render_us;
+    std::size_t particles = 0;
+    std::uint64_t checksum = 0;
+};
+
+void run_scene(const Options& options, int frames, ThreadRun& run) {
+    JobSystem jobs(run.threads);
+    World world(make_generated_level(options.level_width, options.level_height, options.seed), {32.0f, 32.0f});
+    populate_actors(world, options.actors, options.seed);
+    world.reserve_particles(kParticles);
+    world.set_job_system(&jobs);
+    const InputScript script(options.seed);
+    const SpriteRegistry sprites = make_builtin_sprites();
+    RenderList list;
+    SpriteBatcher batcher;
+    FrameArena arena;
+    Rng rng(options.seed);
+    const float level_w = static_cast<float>(world.map().width() * TileMap::kTileSize);
+    const float level_h = static_cast<float>(world.map().height() * TileMap::kTileSize);
+
+    run.update_us.reserve(static_cast<std::size_t>(frames));
+    run.render_us.reserve(static_cast<std::size_t>(frames));
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int b = 0; b < kBurstsPerTick; ++b) {
+            const Vec2 pos{rng.unit() * level_w, rng.unit() * level_h};
+            world.emit_burst(pos, kBurstSize, 0xffd080ffu, rng.next());
+        }
+
+        const std::int64_t t0 = now_ns();
+        world.step(script.at(world.tick()), kDt);
+        const std::int64_t t1 = now_ns();
+        const Camera camera = Camera::follow(world.player_pos(), 640.0f, 360.0f, world.map());
+        build_render_list(world, 1.0f, camera, sprites, list);
+        batcher.build(list, arena, &jobs);
+        const std::int64_t t2 = now_ns();
+        arena.reset();
+
+        run.update_us.push_back(static_cast<double>(t1 - t0) / 1000.0);
+        run.render_us.push_back(static_cast<double>(t2 - t1) / 1000.0);
+    }
+    run.particles = world.particles().size();
+    run.checksum = world.checksum();
+}
+
+} // namespace
+
+bool run_jobs_suite(const Options& options, std::ostream& os) {
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    const int max_threads = options.threads > 0 ? options.threads : (hardware > 0 ? hardware : 1);
+    const int frames = options.frames < kMaxFrames ? options.frames : kMaxFrames;
+
+    std::vector<ThreadRun> runs;
+    for (int t = 1; t <= max_threads; ++t) {
+        runs.emplace_back();
+        runs.back().threads = t;
+        run_scene(options, frames, runs.back());
+    }
+
+    os << "frames: " << frames << "  actors: " << options.actors << "  particles: ~" << runs[0].particles
+       << "  hardware threads: " << hardware << "\n";
+    os << std::left << std::setw(9) << "threads" << std::right << std::setw(14) << "update p50" << std::setw(14)
+       << "update mean" << std::setw(10) << "speedup" << std::setw(14) << "render p50" << std::setw(10)
+       << "speedup" << "\n";
+    const Percentiles base_update = summarize(runs[0].update_us);
+    const Percentiles base_render = summarize(runs[0].render_us);
+    bool deterministic = true;
+    for (ThreadRun& run : runs) {
+        const Percentiles update = summarize(run.update_us);
+        const Percentiles render = summarize(run.render_us);
+        os << std::left << std::setw(9) << run.threads << std::right << std::fixed << std::setprecision(1)
+           << std::setw(12) << update.p50 << "us" << std::setw(12) << update.mean << "us" << std::setw(9)
+           << std::setprecision(2) << base_update.p50 / update.p50 << "x" << std::setprecision(1) << std::setw(12)
+           << render.p50 << "us" << std::setw(9) << std::setprecision(2) << base_render.p50 / render.p50 << "x\n";
+        os.unsetf(std::ios::floatfield);
+        if (run.checksum != runs[0].checksum) {
+            os << "  world checksum differs from the 1-thread run FAIL\n";
+            deterministic = false;
+        }
+    }
+    if (deterministic) os << "all thread counts produced the same world\n";
+    return deterministic;
+}
+
+} // namespace game::bench
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include "bench/alloc_counter.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/cpu_features.hpp"
+#include "core/frame_arena.hpp"
+#include "core/hash.hpp"
+#include "core/pool.hpp"
+#include "core/rng.hpp"
+#include "core/stats.hpp"
+#include "render/atlas.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "sim/particle_system.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr std::size_t kLive = 100000;
+constexpr int kEmitters = 64;
+constexpr float kDt = 1.0f / 120.0f;
+constexpr float kGravity = 400.0f;  // dust and debris drift down slower than sparks
+constexpr float kSpeed = 120.0f;
+constexpr float kViewWidth = 1280.0f;
+constexpr float kViewHeight = 720.0f;
+constexpr float kParticleSize = 2.0f;
+// Lives are spread over [0.5, 1.5) s, so after the warm-up about as many
+// particles expire each tick as the emitters put back.
+constexpr int kWarmupTicks = 240;
+constexpr int kMaxTicks = 600;
+// Emission, integration and render prep of every particle, per tick.
+constexpr double kBudgetUs = 4000.0;
+
+// Bursts that bring the system back up to kLive particles, split over the
+// emitters along the bottom of the view.
+void make_bursts(Rng& rng, std::size_t live, std::vector<ParticleBurst>& bursts) {
+    static constexpr std::uint32_t kColors[] = {0xc8b090ffu, 0xffd080ffu, 0x807060ffu};
+    const std::size_t missing = live < kLive ? kLive - live : 0;
+    for (int e = 0; e < kEmitters; ++e) {
+        ParticleBurst& b = bursts[static_cast<std::size_t>(e)];
+        const auto share = missing / kEmitters + (static_cast<std::size_t>(e) < missing % kEmitters ? 1 : 0);
+        b.pos = {kViewWidth * (static_cast<float>(e) + 0.5f) / kEmitters, kViewHeight * 0.75f};
+        b.count = static_cast<int>(share);
+        b.speed = kSpeed;
+        b.life = 0.5f + rng.unit();
+        b.rgba = kColors[e % 3];
+        b.seed = rng.next();
+    }
+}
+
+// How particles were kept before the structure-of-arrays store: one struct
+// each, integrated with a branch per particle.
+struct AosParticle {
+    Vec2 pos;
+    Vec2 prev;
+    Vec2 vel;
+    float life;
+    std::uint32_t rgba;
+};
+
+void emit_aos(Pool<AosParticle>& pool, const std::vector<ParticleBurst>& bursts) {
+    for (const ParticleBurst& b : bursts) {
+        for (int k = 0; k < b.count; ++k) {
+            AosParticle* p = pool.acquire();
+            if (!p) return;
+            const std::uint32_t h = hash32(b.seed + static_cast<std::uint32_t>(k));
+            const float ux = static_cast<float>(h & 0xffffu) * (2.0f / 65535.0f) - 1.0f;
+            const float uy = static_cast<float>(h >> 16) * (1.0f / 65535.0f);
+            *p = {b.pos, b.pos, {ux * b.speed, -uy * b.speed}, b.life, b.rgba};
+        }
+    }
+}
+
+void update_aos(Pool<AosParticle>& pool, float dt, float gravity) {
+    for (AosParticle& p : pool) {
+        p.life -= dt;
+        if (p.life <= 0.0f) continue;
+        p.prev = p.pos;
+        p.vel.y += gravity * dt;
+        p.pos.x += p.vel.x * dt;
+        p.pos.y += p.vel.y * dt;
+    }
+    for (std::size_t i = 0; i < pool.size();) {
+        if (pool[i].life <= 0.0f) {
+            pool.release(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Hashes what World::checksum() covers, particle by particle, so both
+// layouts hash the same bytes.
+std::uint64_t hash_particles(const ParticleSystem& ps) {
+    std::uint64_t h = fnv1a64(nullptr, 0);
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        h = fnv1a64(&ps.x()[i], sizeof(float), h);
+        h = fnv1a64(&ps.y()[i], sizeof(float), h);
+        h = fnv1a64(&ps.vel_x()[i], sizeof(float), h);
+        h = fnv1a64(&ps.vel_y()[i], sizeof(float), h);
+        h = fnv1a64(&ps.life()[i], sizeof(float), h);
+    }
+    return h;
+}
+
+std::uint64_t hash_particles(const Pool<AosParticle>& pool) {
+    std::uint64_t h = fnv1a64(nullptr, 0);
+    for (const AosParticle& p : pool) {
+        h = fnv1a64(&p.pos, sizeof p.pos, h);
+        h = fnv1a64(&p.vel, sizeof p.vel, h);
+        h = fnv1a64(&p.life, sizeof p.life, h);
+    }
+    return h;
+}
+
+double us_between(std::int64_t t0, std::int64_t t1) { return static_cast<double>(t1 - t0) / 1000.0; }
+
+struct Run {
+    std::vector<double> emit_us, update_us, render_us, total_us;
+    std::size_t live = 0;
+    std::size_t visible = 0;
+    int over_budget = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t hash = 0;
+
+    explicit Run(int ticks) {
+        for (auto* v : {&emit_us, &update_us, &render_us, &total_us}) v->reserve(static_cast<std::size_t>(ticks));
+    }
+};
+
+Run run_soa(const Options& options, int ticks, SimdLevel level, const SpriteRegistry& sprites) {
+    Run r(ticks);
+    ParticleSystem ps(kLive);
+    std::vector<ParticleBurst> bursts(kEmitters);
+    RenderList list;
+    list.particles = {&ps, 0.5f, {0.0f, 0.0f, kViewWidth, kViewHeight}, sprites.frame(kSpriteProjectile),
+                      kParticleSize, kLayerActors};
+    SpriteBatcher batcher;
+    FrameArena arena;
+    Rng rng(options.seed);
+    std::uint64_t allocs_before = 0;
+    for (int t = 0; t < kWarmupTicks + ticks; ++t) {
+        if (t == kWarmupTicks) allocs_before = allocation_count();
+        const std::int64_t t0 = now_ns();
+        make_bursts(rng, ps.size(), bursts);
+        ps.emit(bursts.data(), bursts.size());
+        const std::int64_t t1 = now_ns();
+        ps.update(kDt, kGravity, nullptr, level);
+        const std::int64_t t2 = now_ns();
+        batcher.build(list, arena);
+        const std::int64_t t3 = now_ns();
+        arena.reset();
+        if (t < kWarmupTicks) continue;
+
+        r.emit_us.push_back(us_between(t0, t1));
+        r.update_us.push_back(us_between(t1, t2));
+        r.render_us.push_back(us_between(t2, t3));
+        r.total_us.push_back(us_between(t0, t3));
+        r.over_budget += r.total_us.back() > kBudgetUs ? 1 : 0;
+        r.live += ps.size();
+        r.visible += batcher.stats().particles;
+    }
+    r.allocations = allocation_count() - allocs_before;
+    r.hash = hash_particles(ps);
+    return r;
+}
+
+Run run_aos(const Options& options, int ticks) {
+    Run r(ticks);
+    Pool<AosParticle> pool(kLive);
+    std::vector<ParticleBurst> bursts(kEmitters);
+    Rng rng(options.seed);
+    for (int t = 0; t < kWarmupTicks + ticks; ++t) {
+        const std::int64_t t0 = now_ns();
+        make_bursts(rng, pool.size(), bursts);
+        emit_aos(pool, bursts);
+        const std::int64_t t1 = now_ns();
+        update_aos(pool, kDt, kGravity);
+        const std::int64_t t2 = now_ns();
+        if (t < kWarmupTicks) continue;
+        r.emit_us.push_back(us_between(t0, t1));
+        r.update_us.push_back(us_between(t1, t2));
+    }
+    r.hash = hash_particles(pool);
+    return r;
+}
+
+} // namespace
+
+bool run_particle_suite(const Options& options, std::ostream& os) {
+    const int ticks = std::min(options.frames, kMaxTicks);
+    const SpriteRegistry sprites = make_builtin_sprites();
+    const SimdLevel best = active_simd_level();
+    std::vector<SimdLevel> levels{SimdLevel::Scalar};
+    if (best != SimdLevel::Scalar) levels.push_back(SimdLevel::Sse2);
+    if (best == SimdLevel::Avx2) levels.push_back(SimdLevel::Avx2);
+
+    os << kLive << " live particles from " << kEmitters << " emitters refilling what expires, " << kViewWidth << "x"
+       << kViewHeight << " view, " << ticks << " ticks on one core after " << kWarmupTicks
+       << " warm-up ticks; budget " << kBudgetUs << " us per tick for emit + update + render prep\n";
+    bool ok = true;
+    std::vector<Run> runs;
+    for (SimdLevel level : levels) {
+        runs.push_back(run_soa(options, ticks, level, sprites));
+        const Run& r = runs.back();
+        const bool matched = r.hash == runs[0].hash;
+        ok = ok && matched && r.allocations == 0;
+        os << "\n" << simd_level_name(level) << ": " << r.live / static_cast<std::size_t>(ticks) << " live, "
+           << r.visible / static_cast<std::size_t>(ticks) << " drawn per tick in one batch; " << r.over_budget
+           << " ticks over budget; " << r.allocations << " heap allocations; state "
+           << (matched ? "matches scalar" : "DIFFERS from scalar") << "\n";
+        PercentileTable table(os);
+        table.row("emit", runs.back().emit_us);
+        table.row("update", runs.back().update_us);
+        table.row("render prep", runs.back().render_us);
+        table.row("total", runs.back().total_us);
+    }
+
+    // The same scene with one struct per particle, as World stored them
+    // before; its state has to come out the same.
+    Run aos = run_aos(options, ticks);
+    const bool aos_matched = aos.hash == runs[0].hash;
+    ok = ok && aos_matched;
+    const Percentiles soa_update = summarize(runs.back().update_us);
+    const Percentiles aos_update = summarize(aos.update_us);
+    os << "\nstruct per particle (before): state " << (aos_matched ? "matches" : "DIFFERS") << "; "
+       << simd_level_name(levels.back()) << " update is " << std::fixed << std::setprecision(2)
+       << aos_update.p50 / soa_update.p50 << "x faster at p50\n";
+    os.unsetf(std::ios::floatfield);
+    PercentileTable table(os);
+    table.row("emit", aos.emit_us);
+    table.row("update", aos.update_us);
+    return ok;
+}
+
+} // namespace game::bench
@@ -0,0 +1,97 @@
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <string>
+
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "sim/input_script.hpp"
+#include "sim/levels.hpp"
+#include "sim/replay.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr int kSessionMinutes = 10;
+constexpr int kTickRate = 120;
+// A hand-sized scene: the point is replay throughput and determinism, not
+// the crowd sizes the frame suite stresses.
+constexpr int kMaxActors = 500;
+
+World make_world(const Options& options, int actors) {
+    World world(make_generated_level(options.level_width, options.level_height, options.seed), {32.0f, 32.0f});
+    populate_actors(world, actors, options.seed);
+    return world;
+}
+
+} // namespace
+
+bool run_replay_suite(const Options& options, std::ostream& os) {
+    const int actors = options.actors < kMaxActors ? options.actors : kMaxActors;
+    const std::uint64_t ticks = static_cast<std::uint64_t>(kSessionMinutes) * 60 * kTickRate;
+
+    // Record a scripted session.
+    Replay recording;
+    recording.tick_rate = kTickRate;
+    recording.actor_seed = options.seed;
+    recording.actor_count = static_cast<std::uint32_t>(actors);
+    recording.inputs.reserve(ticks);
+    const std::int64_t record_start = now_ns();
+    {
+        World world = make_world(options, actors);
+        recording.level_hash = hash_level(world.map());
+        const InputScript script(options.seed);
+        const float dt = recording.dt();
+        for (std::uint64_t t = 0; t < ticks; ++t) {
+            const InputState input = script.at(world.tick());
+            world.step(input, dt);
+            recording.record(input, world);
+        }
+        recording.finish(world);
+    }
+    const double record_ms = static_cast<double>(now_ns() - record_start) / 1e6;
+
+    const std::string path = (std::filesystem::temp_directory_path() / "sdl_game_bench.replay").string();
+    std::string error;
+    Replay loaded;
+    bool ok = save_replay(path, recording, &error) && load_replay(path, loaded, &error);
+    const std::uintmax_t file_bytes = ok ? std::filesystem::file_size(path) : 0;
+    std::remove(path.c_str());
+    if (!ok) {
+        os << "replay file round trip failed: " << error << "\n";
+        return false;
+    }
+
+    // The recording run and the replay are separate executions of the same
+    // setup, so matching every checksum shows the simulation is deterministic.
+    World world = make_world(options, actors);
+    if (hash_level(world.map()) != loaded.level_hash) {
+        os << "replay level hash mismatch\n";
+        return false;
+    }
+    const std::int64_t replay_start = now_ns();
+    const ReplayResult result = run_replay(world, loaded);
+    const double replay_ms = static_cast<double>(now_ns() - replay_start) / 1e6;
+
+    const double session_s = static_cast<double>(ticks) / kTickRate;
+    os << "session: " << kSessionMinutes << " min at " << kTickRate << " Hz (" << ticks << " ticks), "
+       << actors << " actors, level " << options.level_width << "x" << options.level_height << "\n";
+    os << "replay file: " << file_bytes << " bytes (" << loaded.checksums.size() << " checksums)\n";
+    os << std::fixed << std::setprecision(1);
+    os << "record:  " << record_ms << " ms\n";
+    os << "replay:  " << replay_ms << " ms  (" << session_s * 1000.0 / replay_ms << "x real time)\n";
+    os.unsetf(std::ios::floatfield);
+    os << "final checksum: " << std::hex << recording.final_checksum << std::dec << "\n";
+
+    const bool pass = loaded.inputs.size() == recording.inputs.size() && result.matched();
+    if (pass) {
+        os << "deterministic: replay matched all " << loaded.checksums.size() + 1 << " checksums\n";
+    } else {
+        os << "replay diverged after tick " << result.diverged_at << " FAIL\n";
+    }
+    return pass;
+}
+
+} // namespace game::bench
@@ -0,0 +1,169 @@
+#include <vector>
+
+#include "bench/alloc_counter.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/rng.hpp"
+#include "sim/input_script.hpp"
+#include "sim/levels.hpp"
+#include "sim/replay.hpp"
+#include "sim/rewind_buffer.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+constexpr int kTickRate = 120;
+constexpr float kDt = 1.0f / kTickRate;
+// At most three seconds of rewind, in as much of the budget as that takes.
+constexpr std::size_t kRingTicks = 3 * kTickRate;
+constexpr std::size_t kBudgetBytes = 128u << 20;
+constexpr int kMeasureTicks = 2000;
+// Ticks rewound by the rollback check, and one tick at a time by the
+// step-back timing.
+constexpr int kRollbackTicks = kTickRate;
+// A tile is toggled every kEditInterval ticks so tile deltas get rewound too.
+constexpr std::uint64_t kEditInterval = 16;
+
+// Deterministic in the tick, so re-simulating after a rollback repeats it.
+void edit_tiles(World& world, std::uint64_t tick) {
+    if (tick % kEditInterval != 0) return;
+    const std::uint32_t h = hash32(static_cast<std::uint32_t>(tick));
+    const int tx = static_cast<int>(h % static_cast<std::uint32_t>(world.map().width()));
+    const int ty = static_cast<int>((h >> 16) % static_cast<std::uint32_t>(world.map().height()));
+    world.set_tile(tx, ty, world.map().solid(tx, ty) ? Tile::Empty : Tile::Solid);
+}
+
+void tick(World& world, const InputScript& script) {
+    edit_tiles(world, world.tick());
+    world.step(script.at(world.tick()), kDt);
+}
+
+// Ticks with a big spark burst every third tick or so, so snapshot sizes
+// swing by tens of KiB from one capture to the next.
+void burst_tick(World& world, const InputScript& script) {
+    tick(world, script);
+    const auto n = static_cast<std::uint32_t>(world.tick());
+    const std::uint32_t h = hash32(n);
+    world.emit_burst(world.player_pos(), static_cast<int>(h % 3 == 0 ? 400 + h % 800 : 0), 0xffffffffu, n);
+}
+
+// A ring about three snapshots big, fed snapshots of varying size so
+// captures wrap and evict unevenly. Every so often every held tick is
+// restored, newest first, and has to match the world as it was captured;
+// the run then carries on from the oldest one.
+constexpr int kWrapActors = 64;
+constexpr int kWrapWarmupTicks = 120;
+constexpr int kWrapRounds = 20;
+constexpr int kWrapTicksPerRound = 37;
+
+bool check_ring_wrap(const Options& options, std::ostream& os) {
+    World world(make_generated_level(options.level_width, options.level_height, options.seed), {32.0f, 32.0f});
+    populate_actors(world, kWrapActors, options.seed);
+    const InputScript script(options.seed);
+    for (int t = 0; t < kWrapWarmupTicks; ++t) burst_tick(world, script);
+    world.clear_tile_edits();
+
+    RewindBuffer ring(3 * world.state_bytes(), kRingTicks);
+    const std::uint64_t first = world.tick() + 1;
+    std::vector<std::uint64_t> checksums, levels;
+    std::size_t restored = 0;
+    bool matched = true;
+    for (int round = 0; round < kWrapRounds && matched; ++round) {
+        for (int t = 0; t < kWrapTicksPerRound; ++t) {
+            burst_tick(world, script);
+            ring.capture(world);
+            const std::size_t at = static_cast<std::size_t>(world.tick() - first);
+            checksums.resize(at + 1);
+            levels.resize(at + 1);
+            checksums[at] = world.checksum();
+            levels[at] = hash_level(world.map());
+        }
+        const std::uint64_t oldest = ring.oldest_tick();
+        for (std::uint64_t t = ring.newest_tick() + 1; t-- > oldest && matched; ++restored) {
+            matched = ring.restore(world, t) && world.checksum() == checksums[t - first] &&
+                      hash_level(world.map()) == levels[t - first];
+        }
+    }
+    os << "\nwrap: " << kWrapRounds * kWrapTicksPerRound << " captures of varying size into room for about 3, "
+       << ring.dropped() << " dropped; " << restored << " restores " << (matched ? "matched" : "DIFFERED FAIL")
+       << "\n";
+    return matched;
+}
+
+} // namespace
+
+bool run_rewind_suite(const Options& options, std::ostream& os) {
+    os << "ring: up to " << kRingTicks << " ticks (" << kRingTicks / kTickRate << " s at " << kTickRate << " Hz) in "
+       << (kBudgetBytes >> 20) << " MiB, a tile edit every " << kEditInterval << " ticks\n";
+    bool ok = true;
+    for (const int actors : {1000, 10000}) {
+        World world(make_generated_level(options.level_width, options.level_height, options.seed), {32.0f, 32.0f});
+        populate_actors(world, actors, options.seed);
+        const InputScript script(options.seed);
+        RewindBuffer ring(kBudgetBytes, kRingTicks);
+
+        // Fill the ring first so captures below evict as they go.
+        for (std::size_t t = 0; t < kRingTicks; ++t) {
+            tick(world, script);
+            ring.capture(world);
+        }
+
+        std::vector<double> capture_us;
+        capture_us.reserve(kMeasureTicks);
+        std::uint64_t capture_allocs = 0;
+        for (int t = 0; t < kMeasureTicks; ++t) {
+            tick(world, script);
+            const std::uint64_t a = allocation_count();
+            const std::int64_t t0 = now_ns();
+            ring.capture(world);
+            capture_us.push_back(static_cast<double>(now_ns() - t0) / 1000.0);
+            capture_allocs += allocation_count() - a;
+        }
+
+        const std::size_t held = ring.size();
+        const std::size_t held_bytes = ring.bytes_used();
+
+        // Rollback: jump back two seconds, re-simulate the same ticks and
+        // land on the same state.
+        const std::uint64_t end_tick = world.tick();
+        const std::uint64_t end_checksum = world.checksum();
+        const std::uint64_t end_level = hash_level(world.map());
+        const std::int64_t r0 = now_ns();
+        const bool restored = ring.restore(world, end_tick - kRollbackTicks);
+        const double rollback_us = static_cast<double>(now_ns() - r0) / 1000.0;
+        for (int t = 0; t < kRollbackTicks; ++t) {
+            tick(world, script);
+            ring.capture(world);
+        }
+        const bool matched = restored && world.tick() == end_tick && world.checksum() == end_checksum &&
+                             hash_level(world.map()) == end_level;
+
+        // Rewinding the way the game does, one tick back per call.
+        std::vector<double> step_back_us;
+        step_back_us.reserve(kRollbackTicks);
+        const std::uint64_t step_allocs_before = allocation_count();
+        for (int t = 0; t < kRollbackTicks; ++t) {
+            const std::int64_t t0 = now_ns();
+            ok = ring.restore(world, world.tick() - 1) && ok;
+            step_back_us.push_back(static_cast<double>(now_ns() - t0) / 1000.0);
+        }
+        const std::uint64_t step_allocs = allocation_count() - step_allocs_before;
+
+        ok = ok && matched && capture_allocs == 0 && step_allocs == 0;
+        os << "\n" << actors << " actors (" << world.actors().size() << " with projectiles): "
+           << world.state_bytes() / 1024 << " KiB per snapshot, " << held << " ticks held in " << held_bytes / 1024
+           << " KiB\n";
+        os << "  rollback " << kRollbackTicks << " ticks: restore " << rollback_us << " us, re-simulated state "
+           << (matched ? "matched" : "DIFFERED") << "\n";
+        os << "  heap allocations: " << capture_allocs << " in capture, " << step_allocs << " in restore\n";
+        PercentileTable table(os);
+        table.row("capture", capture_us);
+        table.row("step back", step_back_us);
+    }
+    ok = check_ring_wrap(options, os) && ok;
+    return ok;
+}
+
+} // namespace game::bench
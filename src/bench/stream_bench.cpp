@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assets/level_file.hpp"
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/hash.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "render/render_list.hpp"
+#include "sim/level_streamer.hpp"
+#include "sim/levels.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+// Fixed-point builds run the first level at World::kMaxLevelTiles and skip
+// the second.
+constexpr int kLevelWidths[] = {std::min(4096, World::kMaxLevelTiles), 32768};
+constexpr int kLevelHeight = 256;
+constexpr float kViewWidth = 640.0f;
+constexpr float kViewHeight = 360.0f;
+// The camera crosses the level at kPanSpeed pixels per frame while drifting
+// up and down, with frames paced kFramePeriod apart so the I/O thread gets
+// a realistic share of time. Memory is sampled every kRssInterval frames.
+constexpr float kPanSpeed = 64.0f;
+constexpr auto kFramePeriod = std::chrono::milliseconds(1);
+constexpr int kRssInterval = 16;
+
+// Resident set size in bytes, or 0 where /proc is unavailable.
+std::size_t resident_bytes() {
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long pages = 0, resident = 0;
+    const int n = std::fscanf(f, "%lu %lu", &pages, &resident);
+    std::fclose(f);
+    return n == 2 ? resident * 4096ul : 0;
+}
+
+struct Traversal {
+    std::vector<double> frame_us;
+    std::vector<std::uint64_t> view_hashes;
+    // Memory held for chunk storage, and how far the resident set grew past
+    // its size at the first frame. RSS is not compared across runs: the
+    // allocator keeps and reuses what earlier runs freed.
+    std::size_t chunk_bytes = 0;
+    std::size_t rss_growth = 0;
+    int worst_missing = 0;
+    LevelStreamer::Stats stats;
+};
+
+int traversal_frames(int level_width) {
+    return static_cast<int>(static_cast<float>(level_width * TileMap::kTileSize) / kPanSpeed);
+}
+
+Camera camera_at(int frame, const TileMap& map) {
+    const float level_h = static_cast<float>(map.height() * TileMap::kTileSize);
+    const float t = static_cast<float>(frame);
+    const Vec2 target{t * kPanSpeed, level_h * 0.5f + (level_h * 0.5f - kViewHeight) * std::sin(t * 0.004f)};
+    return Camera::follow(target, kViewWidth, kViewHeight, map);
+}
+
+// Hash of the tiles in every chunk the view touches, to check a streamed
+// map shows exactly what the full level does.
+std::uint64_t view_hash(const TileMap& map, const Camera& camera) {
+    const float cs = static_cast<float>(TileMap::kTileSize * TileChunk::kSize);
+    std::uint64_t h = kFnv1aOffset;
+    for (int cy = static_cast<int>(camera.y / cs); cy <= static_cast<int>((camera.y + camera.h) / cs); ++cy) {
+        for (int cx = static_cast<int>(camera.x / cs); cx <= static_cast<int>((camera.x + camera.w) / cs); ++cx) {
+            if (cx >= map.chunks_x() || cy >= map.chunks_y()) continue;
+            const TileChunk& c = map.chunk(cx, cy);
+            h = fnv1a64(c.tiles.data(), c.tiles.size(), h);
+        }
+    }
+    return h;
+}
+
+// Crosses the level once. With a streamer the map is paged around the
+// camera; without one it is the fully loaded level. `out` must already be
+// sized to the frame count so filling it doesn't count as growth.
+void traverse(World& world, LevelStreamer* streamer, const SpriteRegistry& sprites, Traversal& out) {
+    const TileMap& map = world.map();
+    const int frames = traversal_frames(map.width());
+    RenderList list;
+    list.cache_tiles = true;
+
+    const std::size_t rss_start = resident_bytes();
+    std::size_t rss_peak = rss_start;
+    auto next_frame = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        const Camera camera = camera_at(frame, map);
+        const std::int64_t t0 = now_ns();
+        if (streamer) streamer->update(world.map(), camera.view());
+        build_render_list(world, 1.0f, camera, sprites, list);
+        const std::int64_t t1 = now_ns();
+        out.frame_us[static_cast<std::size_t>(frame)] = static_cast<double>(t1 - t0) / 1000.0;
+
+        if (streamer) out.worst_missing = std::max(out.worst_missing, streamer->stats().missing_in_view);
+        out.view_hashes[static_cast<std::size_t>(frame)] = view_hash(map, camera);
+        if (frame % kRssInterval == 0) rss_peak = std::max(rss_peak, resident_bytes());
+        next_frame += kFramePeriod;
+        std::this_thread::sleep_until(next_frame);
+    }
+    out.chunk_bytes = static_cast<std::size_t>(map.chunk_slots()) * sizeof(TileChunk);
+    out.rss_growth = rss_peak - rss_start;
+    if (streamer) out.stats = streamer->stats();
+}
+
+} // namespace
+
+bool run_stream_suite(const Options& options, std::ostream& os) {
+    const std::string path = (std::filesystem::temp_directory_path() / "sdl_game_bench.sglv").string();
+    const SpriteRegistry sprites = make_builtin_sprites();
+    // The pan is far faster than anything the game does, so give the I/O
+    // thread two chunks of lead instead of the default one.
+    StreamConfig config;
+    config.margin = 2.0f * static_cast<float>(TileMap::kTileSize * TileChunk::kSize);
+    std::string error;
+    bool ok = true;
+
+    os << "view: " << kViewWidth << "x" << kViewHeight << "  budget: " << config.budget_bytes / 1024
+       << " KiB  margin: " << config.margin << " px  pan: " << kPanSpeed << " px/frame\n";
+    for (const int width : kLevelWidths) {
+        if (width > World::kMaxLevelTiles) {
+            os << "\nlevel " << width << "x" << kLevelHeight << ": skipped, wider than this build's physics handles\n";
+            continue;
+        }
+        {
+            const TileMap level = make_generated_level(width, kLevelHeight, options.seed);
+            if (!save_level_file(path, level, &error)) {
+                os << error << "\n";
+                return false;
+            }
+        }
+
+        const auto frames = static_cast<std::size_t>(traversal_frames(width));
+        Traversal streamed, resident;
+        for (Traversal* t : {&streamed, &resident}) {
+            t->frame_us.resize(frames);
+            t->view_hashes.resize(frames);
+        }
+        {
+            // Untimed run-up, so the streamed measurement below doesn't also
+            // pay for the first I/O thread's heap arena and stack.
+            LevelStreamer streamer;
+            if (!streamer.open(path, config, kViewWidth, kViewHeight, &error)) {
+                os << error << "\n";
+                return false;
+            }
+            TileMap map = streamer.make_map();
+            streamer.prime(map, camera_at(0, map).view());
+        }
+        {
+            LevelStreamer streamer;
+            if (!streamer.open(path, config, kViewWidth, kViewHeight, &error)) {
+                os << error << "\n";
+                return false;
+            }
+            World world(streamer.make_map(), {32.0f, 32.0f});
+            streamer.prime(world.map(), camera_at(0, world.map()).view());
+            traverse(world, &streamer, sprites, streamed);
+        }
+
+        {
+            TileMap level;
+            if (!load_level_file(path, level, &error)) {
+                os << error << "\n";
+                return false;
+            }
+            World world(std::move(level), {32.0f, 32.0f});
+            traverse(world, nullptr, sprites, resident);
+        }
+
+        const bool matched = streamed.view_hashes == resident.view_hashes;
+        ok = ok && matched && streamed.worst_missing == 0 && streamed.stats.read_errors == 0;
+        os << "\nlevel " << width << "x" << kLevelHeight << ", " << streamed.frame_us.size() << " frames\n";
+        for (const Traversal* t : {&streamed, &resident}) {
+            os << "  " << (t == &streamed ? "streamed" : "resident") << ": chunks " << t->chunk_bytes / 1024
+               << " KiB, RSS +" << t->rss_growth / 1024 << " KiB during the traversal\n";
+        }
+        os << "  " << streamed.stats.loads << " loads, " << streamed.stats.evictions << " evictions, "
+           << streamed.stats.dropped << " dropped, most chunks missing from the view: " << streamed.worst_missing
+           << "\n";
+        os << "  view contents " << (matched ? "matched" : "DIFFERED") << " between streamed and resident\n";
+        PercentileTable table(os);
+        table.row("streamed", streamed.frame_us);
+        table.row("resident", resident.frame_us);
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return ok;
+}
+
+} // namespace game::bench
@@ -0,0 +1,89 @@
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/cpu_features.hpp"
+#include "core/rng.hpp"
+#include "sim/swept_aabb.hpp"
+
+namespace game::bench {
+
+namespace {
+
+// Actor-vs-tile sweeps shaped like the ones World::collide produces: actor
+// boxes next to a tile, moving along one axis, with some stationary entries
+// and some touching contacts.
+SweptAabbBatch make_batch(std::size_t n, std::uint32_t seed) {
+    constexpr float kTile = 16.0f;
+    Rng rng(seed);
+    SweptAabbBatch b;
+    for (std::size_t i = 0; i < n; ++i) {
+        const float tx = static_cast<float>(rng.range(0, 511)) * kTile;
+        const float ty = static_cast<float>(rng.range(0, 63)) * kTile;
+        const float w = 4.0f + 12.0f * rng.unit();
+        const float h = 4.0f + 12.0f * rng.unit();
+        float x = tx + (rng.unit() * 3.0f - 1.5f) * kTile;
+        float y = ty + (rng.unit() * 3.0f - 1.5f) * kTile;
+        if (rng.range(0, 7) == 0) y = ty - h;  // resting on top of the tile
+        const float d = (rng.unit() - 0.5f) * 16.0f;
+        const int axis = rng.range(0, 9);
+        const float dx = axis < 4 ? d : (axis < 8 ? 0.0f : d * 0.5f);
+        const float dy = axis < 4 ? 0.0f : (axis < 8 ? d : -d * 0.5f);
+        b.push(static_cast<std::uint32_t>(i), x, y, w, h, dx, dy, tx, ty, kTile, kTile);
+    }
+    return b;
+}
+
+bool same_bits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+} // namespace
+
+bool run_sweep_suite(const Options& options, std::ostream& os) {
+    const SimdLevel best = active_simd_level();
+    std::vector<SimdLevel> levels{SimdLevel::Scalar};
+    if (best != SimdLevel::Scalar) levels.push_back(SimdLevel::Sse2);
+    if (best == SimdLevel::Avx2) levels.push_back(SimdLevel::Avx2);
+
+    os << "cpu: " << simd_level_name(best) << "\n";
+    os << std::left << std::setw(10) << "pairs";
+    for (SimdLevel level : levels) os << std::right << std::setw(14) << simd_level_name(level);
+    os << std::setw(10) << "hits" << "   (ns/pair)\n";
+
+    bool ok = true;
+    for (std::size_t n : {std::size_t{1000}, std::size_t{10000}, std::size_t{100000}, std::size_t{1000000}}) {
+        const SweptAabbBatch batch = make_batch(n, options.seed);
+        // Enough repetitions that every size runs for a comparable time.
+        const int reps = static_cast<int>(std::size_t{4000000} / n);
+
+        SweptContacts reference;
+        sweep_aabbs(batch, reference, SimdLevel::Scalar);
+        std::size_t hits = 0;
+        for (float t : reference.toi) hits += t < 1.0f ? 1 : 0;
+
+        os << std::left << std::setw(10) << n;
+        for (SimdLevel level : levels) {
+            SweptContacts out;
+            sweep_aabbs(batch, out, level);
+            const std::int64_t t0 = now_ns();
+            for (int r = 0; r < reps; ++r) sweep_aabbs(batch, out, level);
+            const double ns = static_cast<double>(now_ns() - t0) / (static_cast<double>(reps) * n);
+            os << std::right << std::fixed << std::setprecision(3) << std::setw(14) << ns;
+            os.unsetf(std::ios::floatfield);
+
+            if (!same_bits(out.toi, reference.toi) || !same_bits(out.nx, reference.nx) ||
+                !same_bits(out.ny, reference.ny)) {
+                os << "\n" << simd_level_name(level) << " contacts differ from scalar at " << n << " pairs";
+                ok = false;
+            }
+        }
+        os << std::setw(10) << hits << "\n";
+    }
+    os << (ok ? "all paths bit-identical to scalar\n" : "\n");
+    return ok;
+}
+
+} // namespace game::bench
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "core/clock.hpp"
+#include "core/frame_arena.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "render/tile_chunk_cache.hpp"
+#include "sim/levels.hpp"
+#include "sim/world.hpp"
+
+namespace game::bench {
+
+namespace {
+
+// Narrower in fixed-point builds, which stop at World::kMaxLevelTiles.
+constexpr int kLevelWidth = std::min(4096, World::kMaxLevelTiles);
+constexpr int kLevelHeight = 256;
+constexpr int kMaxFrames = 5000;
+constexpr float kViewWidth = 640.0f;
+constexpr float kViewHeight = 360.0f;
+// Camera pan speed in pixels per frame, and how often a tile in view is
+// toggled to exercise chunk invalidation.
+constexpr float kPanSpeed = 6.0f;
+constexpr int kEditInterval = 10;
+
+int solid_tiles(const TileChunk& chunk) {
+    int n = 0;
+    for (std::uint32_t row : chunk.solid_rows) {
+        for (; row; row &= row - 1) ++n;
+    }
+    return n;
+}
+
+struct Counts {
+    std::vector<double> tiles;
+    std::vector<double> quads;
+    std::vector<double> prep_us;
+};
+
+void print_counts(std::ostream& os, const char* label, std::vector<double>& samples) {
+    const Percentiles p = summarize(samples);
+    os << "  " << label << ": mean " << p.mean << "  p99 " << p.p99 << "  max " << p.max << "\n";
+}
+
+} // namespace
+
+bool run_tiles_suite(const Options& options, std::ostream& os) {
+    World world(make_generated_level(kLevelWidth, kLevelHeight, options.seed), {32.0f, 32.0f});
+    const TileMap& map = world.map();
+    const SpriteRegistry sprites = make_builtin_sprites();
+    RenderList list;
+    SpriteBatcher batcher;
+    FrameArena arena;
+    TileChunkCache cache;
+
+    const int frames = std::min(options.frames, kMaxFrames);
+    const float level_w = static_cast<float>(map.width() * TileMap::kTileSize);
+    const float level_h = static_cast<float>(map.height() * TileMap::kTileSize);
+    const float ts = static_cast<float>(TileMap::kTileSize);
+    Counts per_tile, cached;
+    for (Counts* c : {&per_tile, &cached}) {
+        c->tiles.reserve(static_cast<std::size_t>(frames));
+        c->quads.reserve(static_cast<std::size_t>(frames));
+        c->prep_us.reserve(static_cast<std::size_t>(frames));
+    }
+
+    std::vector<const TileChunk*> needed;
+    int edits = 0;
+    int chunk_redraws = 0;
+    int edit_redraws = 0;
+    bool covered = true;
+    for (int frame = 0; frame < frames; ++frame) {
+        // Sweep right across the level while bobbing up and down.
+        const float t = static_cast<float>(frame);
+        const Vec2 target{std::fmod(t * kPanSpeed, level_w),
+                          level_h * 0.5f + (level_h * 0.5f - kViewHeight) * std::sin(t * 0.01f)};
+        const Camera camera = Camera::follow(target, kViewWidth, kViewHeight, map);
+
+        const TileChunk* edited = nullptr;
+        if (frame % kEditInterval == kEditInterval - 1) {
+            const int tx = static_cast<int>((camera.x + camera.w * 0.5f) / ts);
+            const int ty = static_cast<int>((camera.y + camera.h * 0.5f) / ts);
+            world.set_tile(tx, ty, map.solid(tx, ty) ? Tile::Empty : Tile::Solid);
+            edited = &map.chunk(tx >> TileChunk::kShift, ty >> TileChunk::kShift);
+            ++edits;
+        }
+
+        // Before: every visible tile is a sprite that goes through the batcher.
+        list.cache_tiles = false;
+        std::int64_t t0 = now_ns();
+        build_render_list(world, 1.0f, camera, sprites, list);
+        batcher.build(list, arena);
+        std::int64_t t1 = now_ns();
+        arena.reset();
+        needed.clear();
+        std::size_t tile_sprites = 0;
+        for (const Sprite& s : list.sprites) {
+            if (s.layer != kLayerTiles) continue;
+            ++tile_sprites;
+            const int tx = static_cast<int>(std::lround((s.dst.x + camera.x) / ts));
+            const int ty = static_cast<int>(std::lround((s.dst.y + camera.y) / ts));
+            needed.push_back(&map.chunk(tx >> TileChunk::kShift, ty >> TileChunk::kShift));
+        }
+        per_tile.tiles.push_back(static_cast<double>(tile_sprites));
+        per_tile.quads.push_back(static_cast<double>(tile_sprites));
+        per_tile.prep_us.push_back(static_cast<double>(t1 - t0) / 1000.0);
+
+        // After: visible chunks are drawn as one quad each, and only chunks
+        // new to the cache or edited since have their tiles drawn again.
+        list.cache_tiles = true;
+        t0 = now_ns();
+        build_render_list(world, 1.0f, camera, sprites, list);
+        batcher.build(list, arena);
+        int redrawn_tiles = 0;
+        for (const ChunkDraw& c : list.chunks) {
+            const TileChunkCache::Lookup lookup = cache.acquire(c.chunk, static_cast<std::uint64_t>(frame));
+            if (!lookup.redraw) continue;
+            redrawn_tiles += solid_tiles(*c.chunk);
+            ++chunk_redraws;
+            if (c.chunk == edited) ++edit_redraws;
+        }
+        t1 = now_ns();
+        arena.reset();
+        for (const TileChunk* chunk : needed) {
+            covered = covered && std::any_of(list.chunks.begin(), list.chunks.end(),
+                                             [&](const ChunkDraw& c) { return c.chunk == chunk; });
+        }
+        cached.tiles.push_back(static_cast<double>(redrawn_tiles));
+        cached.quads.push_back(static_cast<double>(list.chunks.size()));
+        cached.prep_us.push_back(static_cast<double>(t1 - t0) / 1000.0);
+    }
+
+    os << "frames: " << frames << "  level: " << kLevelWidth << "x" << kLevelHeight << " tiles ("
+       << map.chunks_x() << "x" << map.chunks_y() << " chunks of " << TileChunk::kSize << "x" << TileChunk::kSize
+       << ")  view: " << kViewWidth << "x" << kViewHeight << "  cache slots: " << TileChunkCache::kSlots << "\n";
+    os << "one tile edited every " << kEditInterval << " frames: " << edits << " edits\n";
+    os << "chunk redraws: " << chunk_redraws << " (" << edit_redraws << " of edited chunks, the rest on entering "
+       << "the cache)\n";
+    os << "per-tile sprites\n";
+    print_counts(os, "tiles drawn/frame", per_tile.tiles);
+    print_counts(os, "tile quads/frame", per_tile.quads);
+    os << "cached chunks\n";
+    print_counts(os, "tiles drawn/frame", cached.tiles);
+    print_counts(os, "chunk quads/frame", cached.quads);
+    if (!covered) os << "a visible tile's chunk was not emitted FAIL\n";
+    PercentileTable table(os);
+    table.row("prep tiles", per_tile.prep_us);
+    table.row("prep chunks", cached.prep_us);
+    return covered;
+}
+
+} // namespace game::bench
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace game {
+
+// Widest vector instruction set the hot kernels may use on this CPU.
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// Detected once at startup; kernels dispatch on this at runtime so a single
+// binary runs everywhere.
+SimdLevel detect_simd_level();
+
+// detect_simd_level(), cached on first use.
+SimdLevel active_simd_level();
+
+const char* simd_level_name(SimdLevel level);
+
+} // namespace game
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game {
+
+// Signed 16.16 fixed-point number: integers up to +-32767 in steps of
+// 1/65536. Every operation is plain integer arithmetic, so results are the
+// same on every compiler, CPU and optimisation level without the care float
+// needs for that (no FMA contraction, no x87, no fast-math).
+//
+// Nothing saturates except division; keep values inside the range (a world
+// of up to 2047 tiles across, World::kMaxLevelTiles).
+struct Fixed {
+    static constexpr int kFracBits = 16;
+    static constexpr std::int32_t kOne = 1 << kFracBits;
+
+    std::int32_t raw = 0;
+
+    constexpr Fixed() = default;
+    // Rounds to the nearest step. Exact for whole numbers and for the
+    // power-of-two fractions game constants tend to use.
+    constexpr explicit Fixed(float v)
+        : raw(static_cast<std::int32_t>(static_cast<double>(v) * kOne + (v < 0.0f ? -0.5 : 0.5))) {}
+
+    static constexpr Fixed from_raw(std::int32_t r) {
+        Fixed f;
+        f.raw = r;
+        return f;
+    }
+
+    constexpr Fixed operator-() const { return from_raw(-raw); }
+    constexpr Fixed& operator+=(Fixed o) {
+        raw += o.raw;
+        return *this;
+    }
+    constexpr Fixed& operator-=(Fixed o) {
+        raw -= o.raw;
+        return *this;
+    }
+};
+
+constexpr Fixed operator+(Fixed a, Fixed b) { return Fixed::from_raw(a.raw + b.raw); }
+constexpr Fixed operator-(Fixed a, Fixed b) { return Fixed::from_raw(a.raw - b.raw); }
+// Rounds toward negative infinity.
+constexpr Fixed operator*(Fixed a, Fixed b) {
+    return Fixed::from_raw(static_cast<std::int32_t>((static_cast<std::int64_t>(a.raw) * b.raw) >> Fixed::kFracBits));
+}
+// Rounds toward zero and saturates, so dividing by a tiny value gives a huge
+// result rather than a wrapped one. b must not be zero.
+constexpr Fixed operator/(Fixed a, Fixed b) {
+    const std::int64_t q = (static_cast<std::int64_t>(a.raw) * Fixed::kOne) / b.raw;
+    return Fixed::from_raw(q > INT32_MAX ? INT32_MAX : (q < -INT32_MAX ? -INT32_MAX : static_cast<std::int32_t>(q)));
+}
+
+constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+// Largest value; the fixed-point stand-in for infinity.
+constexpr Fixed kFixedMax = Fixed::from_raw(INT32_MAX);
+
+constexpr float to_float(Fixed v) { return static_cast<float>(v.raw) * (1.0f / Fixed::kOne); }
+constexpr float to_float(float v) { return v; }
+
+// Integer containing v, and the smallest integer not below it.
+constexpr int floor_int(Fixed v) { return v.raw >> Fixed::kFracBits; }
+constexpr int ceil_int(Fixed v) { return (v.raw + (Fixed::kOne - 1)) >> Fixed::kFracBits; }
+// Written out rather than via std::floor/ceil, which are library calls on
+// baseline x86-64 and dominated the per-actor cost of the tile sweeps.
+inline int floor_int(float v) {
+    const int i = static_cast<int>(v);
+    return i - (v < static_cast<float>(i) ? 1 : 0);
+}
+inline int ceil_int(float v) {
+    const int i = static_cast<int>(v);
+    return i + (v > static_cast<float>(i) ? 1 : 0);
+}
+
+// The number type of actor positions, velocities and sizes and of the tile
+// collision math: float by default, Fixed when built with
+// -DSDL_GAME_FIXED_POINT=ON. Code written against Real, or templated on the
+// number type, runs unchanged in both builds.
+#ifdef GAME_FIXED_POINT
+using Real = Fixed;
+#else
+using Real = float;
+#endif
+
+} // namespace game
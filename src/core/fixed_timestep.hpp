@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace game {
+
+// Accumulator for a fixed-rate simulation driven by a variable-rate frame loop.
+//
+// Each frame the caller reports how much wall-clock time passed; advance()
+// returns how many fixed ticks to simulate and alpha() how far the frame sits
+// between the last two simulated states, for render interpolation. Frames that
+// would need more than max_ticks_per_frame ticks drop the excess time instead
+// of spiralling (the game slows down rather than freezing).
+class FixedTimestep {
+public:
+    explicit FixedTimestep(double tick_rate_hz = 120.0, int max_ticks_per_frame = 8)
+        : dt_(1.0 / tick_rate_hz), max_ticks_(max_ticks_per_frame) {}
+
+    int advance(double frame_seconds) {
+        if (frame_seconds < 0.0) frame_seconds = 0.0;
+        accumulator_ += frame_seconds;
+        int ticks = 0;
+        while (accumulator_ >= dt_ && ticks < max_ticks_) {
+            accumulator_ -= dt_;
+            ++ticks;
+        }
+        if (ticks == max_ticks_ && accumulator_ >= dt_) {
+            const double whole_ticks = std::floor(accumulator_ / dt_) * dt_;
+            dropped_seconds_ += whole_ticks;
+            accumulator_ -= whole_ticks;
+        }
+        tick_ += static_cast<std::uint64_t>(ticks);
+        return ticks;
+    }
+
+    // Fraction of a tick left in the accumulator, in [0, 1).
+    double alpha() const { return accumulator_ / dt_; }
+    double dt() const { return dt_; }
+    std::uint64_t tick() const { return tick_; }
+    double dropped_seconds() const { return dropped_seconds_; }
+
+private:
+    double dt_;
+    int max_ticks_;
+    double accumulator_ = 0.0;
+    double dropped_seconds_ = 0.0;
+    std::uint64_t tick_ = 0;
+};
+
+} // namespace game
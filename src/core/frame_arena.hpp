@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace game {
+
+// Bump allocator for data that lives for one frame (vertex buffers, scratch
+// lists). Allocation is a pointer bump; reset() frees everything at once.
+//
+// If a frame needs more than the current capacity the extra requests are
+// served from overflow blocks, and the next reset() grows the main block to
+// the high-water mark so steady-state frames never touch the heap.
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t capacity = 1u << 20) { grow(capacity); }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block_.get());
+        const std::uintptr_t p = (base + used_ + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+        const std::size_t end = static_cast<std::size_t>(p - base) + bytes;
+        if (end <= capacity_) {
+            used_ = end;
+            return reinterpret_cast<void*>(p);
+        }
+        return allocate_overflow(bytes, align);
+    }
+
+    // Uninitialised storage for n trivially destructible objects.
+    template <typename T>
+    T* alloc_array(std::size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destructed");
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void reset() {
+        if (!overflow_.empty()) {
+            const std::size_t high_water = used_ + overflow_bytes_;
+            overflow_.clear();
+            overflow_bytes_ = 0;
+            grow(high_water + high_water / 2);
+        }
+        used_ = 0;
+    }
+
+    std::size_t used() const { return used_ + overflow_bytes_; }
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    void grow(std::size_t capacity) {
+        block_.reset(new std::byte[capacity]);
+        capacity_ = capacity;
+        used_ = 0;
+    }
+
+    void* allocate_overflow(std::size_t bytes, std::size_t align) {
+        overflow_.emplace_back(new std::byte[bytes + align]);
+        overflow_bytes_ += bytes + align;
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(overflow_.back().get());
+        return reinterpret_cast<void*>((base + align - 1) & ~static_cast<std::uintptr_t>(align - 1));
+    }
+
+    std::unique_ptr<std::byte[]> block_;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+    std::vector<std::unique_ptr<std::byte[]>> overflow_;
+    std::size_t overflow_bytes_ = 0;
+};
+
+} // namespace game
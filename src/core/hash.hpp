@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace game {
+
+constexpr std::uint64_t kFnv1aOffset = 14695981039346656037ull;
+
+// 64-bit FNV-1a over raw bytes. Chain calls by passing the previous result as
+// `h`. Used for state checksums (replay verification), not hash tables.
+inline std::uint64_t fnv1a64(const void* data, std::size_t size, std::uint64_t h = kFnv1aOffset) {
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace game
@@ -0,0 +1,162 @@
+#include "core/job_system.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "core/profiler.hpp"
+
+namespace game {
+
+namespace {
+
+// Upper bound on chunks per parallel_for; their jobs live on the caller's
+// stack.
+constexpr std::uint32_t kMaxChunks = 256;
+// Chunks per thread, so a thread that finishes early can steal a share of
+// the remaining work instead of idling.
+constexpr std::uint32_t kChunksPerThread = 4;
+// Failed scans a worker makes, yielding between them, before it sleeps.
+constexpr int kSpinsBeforeSleep = 512;
+
+thread_local const JobSystem* t_system = nullptr;
+thread_local int t_queue = 0;
+
+} // namespace
+
+bool JobSystem::Deque::push(Job* job) {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t >= kCapacity) return false;
+    slots_[b & (kCapacity - 1)].store(job, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+JobSystem::Job* JobSystem::Deque::pop() {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Job* job = slots_[b & (kCapacity - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Last job: race any thief for it.
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+JobSystem::Job* JobSystem::Deque::steal() {
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) return nullptr;
+    Job* job = slots_[t & (kCapacity - 1)].load(std::memory_order_acquire);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+JobSystem::JobSystem(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Deque>());
+    // Queue 0 belongs to the owning thread; workers take 1..threads-1.
+    for (int i = 1; i < threads; ++i) workers_.emplace_back(&JobSystem::worker_main, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
+        epoch_.fetch_add(1);
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_) t.join();
+}
+
+int JobSystem::current_queue() const { return t_system == this ? t_queue : 0; }
+
+void JobSystem::run_chunks(std::uint32_t count, std::uint32_t grain, JobFn fn, void* ctx) {
+    const std::uint32_t threads = static_cast<std::uint32_t>(thread_count());
+    const std::uint32_t chunks = std::min({count / grain, threads * kChunksPerThread, kMaxChunks});
+    Job jobs[kMaxChunks];
+    std::atomic<std::uint32_t> pending{chunks};
+
+    Deque& queue = *queues_[static_cast<std::size_t>(current_queue())];
+    for (std::uint32_t c = 0; c < chunks; ++c) {
+        const auto begin = static_cast<std::uint32_t>(static_cast<std::uint64_t>(count) * c / chunks);
+        const auto end = static_cast<std::uint32_t>(static_cast<std::uint64_t>(count) * (c + 1) / chunks);
+        jobs[c] = {fn, ctx, begin, end, &pending};
+        if (!queue.push(&jobs[c])) {
+            fn(ctx, begin, end);
+            pending.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+        wake_.notify_all();
+    }
+
+    const int self = current_queue();
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!run_one(self)) std::this_thread::yield();
+    }
+}
+
+bool JobSystem::run_one(int self) {
+    const int n = thread_count();
+    Job* job = queues_[static_cast<std::size_t>(self)]->pop();
+    for (int k = 1; !job && k < n; ++k) job = queues_[static_cast<std::size_t>((self + k) % n)]->steal();
+    if (!job) return false;
+    GAME_PROFILE_SCOPE("job");
+    job->fn(job->ctx, job->begin, job->end);
+    job->pending->fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::worker_main(int index) {
+    t_system = this;
+    t_queue = index;
+    char name[32];
+    std::snprintf(name, sizeof name, "worker %d", index);
+    profile::set_thread_name(name);
+    int idle = 0;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (run_one(index)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < kSpinsBeforeSleep) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Announce the sleep, then look once more so a push that raced with
+        // the announcement is not missed.
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        const std::uint64_t seen = epoch_.load(std::memory_order_seq_cst);
+        if (run_one(index)) {
+            sleepers_.fetch_sub(1);
+            idle = 0;
+            continue;
+        }
+        {
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [&] { return epoch_.load() != seen || stop_.load(); });
+        }
+        sleepers_.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+} // namespace game
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace game {
+
+// Small work-stealing scheduler for splitting data-parallel loops across
+// cores.
+//
+// Every participating thread (the owner thread plus thread_count() - 1
+// workers) has its own Chase-Lev deque. parallel_for() pushes its chunks on
+// the calling thread's deque and then helps run them; idle threads pop from
+// their own deque first and steal from the others' tops otherwise, so a
+// nested parallel_for inside a job spreads the same way. Workers spin
+// briefly between bursts of work and then sleep until more is pushed.
+//
+// parallel_for() may be called from the thread that created the system or
+// from inside a job, never from other threads. Only the caller's chunks are
+// guaranteed done when it returns. Chunk boundaries depend on the thread
+// count, so callers must make each element's result independent of how the
+// range was split if they want identical output at any thread count.
+class JobSystem {
+public:
+    // threads counts the calling thread; 0 means one per hardware thread.
+    explicit JobSystem(int threads = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int thread_count() const { return static_cast<int>(queues_.size()); }
+
+    // Runs fn(begin, end) over disjoint chunks covering [0, count), each at
+    // least `grain` items long (except the last), and returns once all of
+    // them have finished.
+    template <typename Fn>
+    void parallel_for(std::uint32_t count, std::uint32_t grain, Fn&& fn) {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        if (thread_count() == 1 || count <= grain) {
+            fn(0u, count);
+            return;
+        }
+        using F = std::remove_reference_t<Fn>;
+        run_chunks(count, grain, [](void* ctx, std::uint32_t begin, std::uint32_t end) {
+            (*static_cast<F*>(ctx))(begin, end);
+        }, const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+private:
+    using JobFn = void (*)(void* ctx, std::uint32_t begin, std::uint32_t end);
+
+    struct Job {
+        JobFn fn;
+        void* ctx;
+        std::uint32_t begin;
+        std::uint32_t end;
+        std::atomic<std::uint32_t>* pending;
+    };
+
+    // Chase-Lev deque of job pointers with a fixed power-of-two capacity.
+    // The owner pushes and pops at the bottom; thieves take from the top.
+    class Deque {
+    public:
+        static constexpr std::int64_t kCapacity = 1024;
+
+        bool push(Job* job);
+        Job* pop();
+        Job* steal();
+
+    private:
+        alignas(64) std::atomic<std::int64_t> top_{0};
+        alignas(64) std::atomic<std::int64_t> bottom_{0};
+        std::atomic<Job*> slots_[kCapacity];
+    };
+
+    void run_chunks(std::uint32_t count, std::uint32_t grain, JobFn fn, void* ctx);
+    // Pops or steals one job and runs it. Returns false if none was found.
+    bool run_one(int self);
+    void worker_main(int index);
+    int current_queue() const;
+
+    std::vector<std::unique_ptr<Deque>> queues_;
+    std::vector<std::thread> workers_;
+
+    // Sleep/wake for idle workers. epoch_ is bumped whenever jobs are pushed.
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<std::uint64_t> epoch_{0};
+    std::atomic<int> sleepers_{0};
+    std::atomic<bool> stop_{false};
+};
+
+// parallel_for on `jobs`, or a plain call over the whole range when there is
+// no job system, so single-threaded callers need no special case.
+template <typename Fn>
+void parallel_for(JobSystem* jobs, std::uint32_t count, std::uint32_t grain, Fn&& fn) {
+    if (jobs) {
+        jobs->parallel_for(count, grain, fn);
+    } else if (count > 0) {
+        fn(0u, count);
+    }
+}
+
+} // namespace game
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace game {
+
+// Fixed-capacity storage for short-lived objects of one type (particles,
+// projectile spawns, contacts, render commands).
+//
+// Live objects are kept packed at the front, so a pool iterates like an
+// array and release() swap-removes like ActorStore does. All memory is
+// claimed up front by the constructor or reserve(); acquire() never
+// allocates and returns nullptr once the pool is full, counting the drop so
+// callers can size capacities from real runs.
+template <typename T>
+class Pool {
+    static_assert(std::is_trivially_destructible<T>::value, "pooled objects are never destructed");
+
+public:
+    explicit Pool(std::size_t capacity = 0) { reserve(capacity); }
+
+    // Grows the capacity, keeping live objects. The only call that touches
+    // the heap, so do it at load time rather than mid-frame.
+    void reserve(std::size_t capacity) {
+        if (capacity > items_.size()) items_.resize(capacity);
+    }
+
+    T* acquire() {
+        if (size_ == items_.size()) {
+            ++dropped_;
+            return nullptr;
+        }
+        return &items_[size_++];
+    }
+
+    // n contiguous objects, or nullptr (counting n drops) if they do not fit.
+    T* acquire_n(std::size_t n) {
+        if (items_.size() - size_ < n) {
+            dropped_ += n;
+            return nullptr;
+        }
+        T* first = items_.data() + size_;
+        size_ += n;
+        return first;
+    }
+
+    bool push(const T& value) {
+        T* slot = acquire();
+        if (!slot) return false;
+        *slot = value;
+        return true;
+    }
+
+    // Swap-removes the object at index i; the last object takes its place.
+    void release(std::size_t i) {
+        --size_;
+        if (i != size_) items_[i] = items_[size_];
+    }
+
+    void clear() { size_ = 0; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return items_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == items_.size(); }
+    // acquire() calls that failed because the pool was full.
+    std::uint64_t dropped() const { return dropped_; }
+
+    T* data() { return items_.data(); }
+    const T* data() const { return items_.data(); }
+    T& operator[](std::size_t i) { return items_[i]; }
+    const T& operator[](std::size_t i) const { return items_[i]; }
+    T* begin() { return items_.data(); }
+    T* end() { return items_.data() + size_; }
+    const T* begin() const { return items_.data(); }
+    const T* end() const { return items_.data() + size_; }
+
+private:
+    std::vector<T> items_;
+    std::size_t size_ = 0;
+    std::uint64_t dropped_ = 0;
+};
+
+} // namespace game
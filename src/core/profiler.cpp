@@ -0,0 +1,171 @@
+#include "core/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "core/clock.hpp"
+
+namespace game::profile {
+
+namespace {
+
+struct Ring {
+    Event events[kRingEvents];
+    // Events ever written; the ring holds the last min(count, kRingEvents).
+    std::atomic<std::uint64_t> count{0};
+    // Events before this one were discarded. Only the owner writes it.
+    std::atomic<std::uint64_t> first{0};
+    std::uint32_t depth = 0;
+    std::uint32_t id = 0;
+    char name[32] = {};
+    Ring* next = nullptr;
+};
+
+// Every ring ever created, pushed lock-free. Rings are never freed, so a
+// trace still shows threads that have exited.
+std::atomic<Ring*> g_rings{nullptr};
+std::atomic<std::uint32_t> g_next_id{0};
+
+Ring* register_ring() {
+    Ring* ring = new Ring;
+    ring->id = g_next_id.fetch_add(1, std::memory_order_relaxed);
+    std::snprintf(ring->name, sizeof ring->name, "thread %u", ring->id);
+    ring->next = g_rings.load(std::memory_order_relaxed);
+    while (!g_rings.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return ring;
+}
+
+Ring& thread_ring() {
+    thread_local Ring* ring = register_ring();
+    return *ring;
+}
+
+// Index of the oldest event still held, given `count` events written.
+std::uint64_t oldest_event(const Ring& ring, std::uint64_t count) {
+    return std::max(ring.first.load(std::memory_order_relaxed), count > kRingEvents ? count - kRingEvents : 0);
+}
+
+template <typename Visit>
+void for_each_event(const Ring& ring, Visit&& visit) {
+    const std::uint64_t count = ring.count.load(std::memory_order_acquire);
+    const std::uint64_t first = oldest_event(ring, count);
+    for (std::uint64_t i = first; i < count; ++i) visit(ring.events[i % kRingEvents]);
+}
+
+void write_json_string(std::ostream& os, const char* s) {
+    os << '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') os << '\\';
+        os << *s;
+    }
+    os << '"';
+}
+
+} // namespace
+
+#if GAME_PROFILING
+Scope::Scope(const char* name) : name_(name) {
+    ++thread_ring().depth;
+    begin_ns_ = now_ns();
+}
+
+Scope::~Scope() {
+    const std::int64_t end_ns = now_ns();
+    Ring& ring = thread_ring();
+    --ring.depth;
+    const std::uint64_t i = ring.count.load(std::memory_order_relaxed);
+    ring.events[i % kRingEvents] = {name_, begin_ns_, end_ns, ring.depth};
+    ring.count.store(i + 1, std::memory_order_release);
+}
+#endif
+
+void set_thread_name(const char* name) {
+    if (!kEnabled) return;
+    Ring& ring = thread_ring();
+    std::snprintf(ring.name, sizeof ring.name, "%s", name);
+}
+
+void thread_events(std::vector<Event>& out) {
+    out.clear();
+    if (!kEnabled) return;
+    for_each_event(thread_ring(), [&](const Event& e) { out.push_back(e); });
+}
+
+void visit_thread_events(std::int64_t since_ns, void (*visit)(const Event& event, void* ctx), void* ctx) {
+    if (!kEnabled) return;
+    // Scopes are appended as they end, so end_ns never decreases along the
+    // ring: walk back from the newest event to the first one that ended
+    // before since_ns, then visit forward from there. A frame's events cost
+    // a few steps rather than a pass over the whole ring.
+    const Ring& ring = thread_ring();
+    const std::uint64_t count = ring.count.load(std::memory_order_relaxed);
+    const std::uint64_t first = oldest_event(ring, count);
+    std::uint64_t start = count;
+    while (start > first && ring.events[(start - 1) % kRingEvents].end_ns >= since_ns) --start;
+    for (std::uint64_t i = start; i < count; ++i) visit(ring.events[i % kRingEvents], ctx);
+}
+
+void discard_thread_events() {
+    if (!kEnabled) return;
+    Ring& ring = thread_ring();
+    ring.first.store(ring.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::vector<ThreadTrace> collect() {
+    std::vector<ThreadTrace> traces;
+    for (const Ring* ring = g_rings.load(std::memory_order_acquire); ring; ring = ring->next) {
+        ThreadTrace t;
+        t.id = ring->id;
+        t.name = ring->name;
+        for_each_event(*ring, [&](const Event& e) { t.events.push_back(e); });
+        traces.push_back(std::move(t));
+    }
+    std::sort(traces.begin(), traces.end(), [](const ThreadTrace& a, const ThreadTrace& b) { return a.id < b.id; });
+    return traces;
+}
+
+bool write_chrome_trace(const std::string& path, std::string* error) {
+    const std::vector<ThreadTrace> traces = collect();
+    std::int64_t origin = INT64_MAX;
+    for (const ThreadTrace& t : traces) {
+        for (const Event& e : t.events) origin = std::min(origin, e.begin_ns);
+    }
+
+    std::ofstream os(path);
+    if (!os) {
+        if (error) *error = "cannot write " + path;
+        return false;
+    }
+    // Complete ("X") events with microsecond timestamps relative to the
+    // oldest event, plus a thread_name metadata event per thread.
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    char buf[96];
+    for (const ThreadTrace& t : traces) {
+        os << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << t.id
+           << ",\"args\":{\"name\":";
+        write_json_string(os, t.name.c_str());
+        os << "}}";
+        first = false;
+        for (const Event& e : t.events) {
+            os << ",\n{\"ph\":\"X\",\"name\":";
+            write_json_string(os, e.name);
+            std::snprintf(buf, sizeof buf, ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", t.id,
+                          static_cast<double>(e.begin_ns - origin) / 1000.0,
+                          static_cast<double>(e.end_ns - e.begin_ns) / 1000.0);
+            os << buf;
+        }
+    }
+    os << "\n]}\n";
+    if (!os) {
+        if (error) *error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace game::profile
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scoped timing markers for the hot path.
+//
+//   void World::collide(float dt) {
+//       GAME_PROFILE_SCOPE("collide");
+//       ...
+//
+// Each thread appends finished scopes to its own fixed-size ring buffer, so
+// recording takes no locks and never allocates after the thread's first
+// scope; the oldest events are overwritten once the ring is full. Release-lite
+// builds (GAME_RELEASE_LITE) compile the markers out entirely; the query and
+// export functions still exist and simply report nothing.
+
+#if defined(GAME_RELEASE_LITE)
+#define GAME_PROFILING 0
+#else
+#define GAME_PROFILING 1
+#endif
+
+namespace game::profile {
+
+// One finished scope. `name` must be a string literal (it is stored as a
+// pointer). depth counts the scopes that were open around it on its thread.
+struct Event {
+    const char* name;
+    std::int64_t begin_ns;
+    std::int64_t end_ns;
+    std::uint32_t depth;
+};
+
+constexpr std::size_t kRingEvents = 1u << 16;
+constexpr bool kEnabled = GAME_PROFILING != 0;
+
+#if GAME_PROFILING
+class Scope {
+public:
+    explicit Scope(const char* name);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+    std::int64_t begin_ns_;
+};
+
+#define GAME_PROFILE_CONCAT_(a, b) a##b
+#define GAME_PROFILE_CONCAT(a, b) GAME_PROFILE_CONCAT_(a, b)
+#define GAME_PROFILE_SCOPE(name) ::game::profile::Scope GAME_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#else
+#define GAME_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+// Names the calling thread in exported traces and sets up its ring, so call
+// it when a thread starts rather than paying for that on its first scope.
+void set_thread_name(const char* name);
+
+// The calling thread's events, oldest first, that are still in its ring.
+// Other threads' rings are not touched, so this is safe at any time.
+void thread_events(std::vector<Event>& out);
+// Calls visit(event) for the calling thread's events that ended at or after
+// since_ns, oldest first, without copying the ring. Costs one step per
+// event visited, however full the ring is.
+void visit_thread_events(std::int64_t since_ns, void (*visit)(const Event& event, void* ctx), void* ctx);
+// Forgets the calling thread's events so far, e.g. after a warm-up.
+void discard_thread_events();
+
+struct ThreadTrace {
+    std::uint32_t id = 0;
+    std::string name;
+    std::vector<Event> events;
+};
+
+// Copies every thread's ring. Rings are read without synchronising with
+// their writers, so only call this while other threads are not recording,
+// e.g. between frames when the job system is idle.
+std::vector<ThreadTrace> collect();
+
+// Writes collect() as Chrome trace-event JSON (chrome://tracing, Perfetto).
+bool write_chrome_trace(const std::string& path, std::string* error);
+
+} // namespace game::profile
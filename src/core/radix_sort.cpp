@@ -0,0 +1,51 @@
+#include "core/radix_sort.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace game {
+
+namespace {
+
+constexpr int kPasses = 8;
+constexpr int kBuckets = 256;
+// Below this many keys the histograms cost more than comparison sorting.
+constexpr std::size_t kMinRadixKeys = 64;
+
+} // namespace
+
+void radix_sort(std::uint64_t* keys, std::uint64_t* scratch, std::size_t n) {
+    if (n < kMinRadixKeys) {
+        std::sort(keys, keys + n);
+        return;
+    }
+
+    std::uint32_t counts[kPasses][kBuckets] = {};
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint64_t k = keys[i];
+        for (int p = 0; p < kPasses; ++p) ++counts[p][(k >> (p * 8)) & 0xff];
+    }
+
+    std::uint64_t* src = keys;
+    std::uint64_t* dst = scratch;
+    for (int p = 0; p < kPasses; ++p) {
+        std::uint32_t* count = counts[p];
+        const int shift = p * 8;
+        if (count[(src[0] >> shift) & 0xff] == n) continue;
+        // Counts become each bucket's first output position.
+        std::uint32_t sum = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            const std::uint32_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint64_t k = src[i];
+            dst[count[(k >> shift) & 0xff]++] = k;
+        }
+        std::swap(src, dst);
+    }
+    if (src != keys) std::memcpy(keys, src, n * sizeof(std::uint64_t));
+}
+
+} // namespace game
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace game {
+
+// Sorts n keys ascending with a least-significant-digit radix sort, one byte
+// per pass. scratch must hold n keys; the sorted keys end up in `keys`. n
+// must be below 2^32.
+//
+// One read builds every byte's histogram up front, and a pass is skipped
+// when all keys share that byte, so packed keys whose high fields take few
+// values (layers, atlas pages) sort in fewer than eight passes. Stable, and
+// never allocates.
+void radix_sort(std::uint64_t* keys, std::uint64_t* scratch, std::size_t n);
+
+} // namespace game
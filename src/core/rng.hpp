@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game {
+
+// Integer hash with good avalanche, used for stateless per-tick randomness.
+inline std::uint32_t hash32(std::uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+// Small deterministic generator (xorshift32). The simulation never uses
+// std::rand or <random> distributions so results do not depend on the
+// standard library implementation.
+class Rng {
+public:
+    explicit Rng(std::uint32_t seed = 1) : state_(hash32(seed) | 1u) {}
+
+    std::uint32_t next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+
+    // Uniform integer in [lo, hi].
+    int range(int lo, int hi) {
+        const std::uint32_t span = static_cast<std::uint32_t>(hi - lo) + 1u;
+        return lo + static_cast<int>(next() % span);
+    }
+
+    // Uniform float in [0, 1).
+    float unit() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    std::uint32_t state() const { return state_; }
+    void set_state(std::uint32_t s) { state_ = s; }
+
+private:
+    std::uint32_t state_;
+};
+
+} // namespace game
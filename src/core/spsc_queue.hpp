@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace game {
+
+// Bounded single-producer single-consumer ring. One thread may push and one
+// other thread may pop, with no locks and no allocation after construction;
+// both fail instead of waiting when the ring is full or empty.
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied in and out of the ring");
+
+public:
+    // capacity is rounded up to a power of two.
+    explicit SpscQueue(std::size_t capacity) {
+        std::size_t n = 1;
+        while (n < capacity) n <<= 1;
+        items_ = std::make_unique<T[]>(n);
+        mask_ = n - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // Producer side.
+    bool push(const T& item) {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) return false;
+        }
+        items_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool pop(T& out) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return false;
+        }
+        out = items_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: the oldest item, or nullptr if empty. It stays valid
+    // until pop(), so large items can be used in place instead of copied.
+    const T* front() {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) return nullptr;
+        }
+        return &items_[head & mask_];
+    }
+
+    // Consumer side: removes the item front() returned.
+    void pop() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    std::unique_ptr<T[]> items_;
+    std::size_t mask_ = 0;
+    // Each side caches the other's index so it only touches the shared
+    // cache line when the ring looks full or empty.
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    std::uint64_t tail_cache_ = 0;
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+    std::uint64_t head_cache_ = 0;
+};
+
+} // namespace game
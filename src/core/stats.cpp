@@ -0,0 +1,33 @@
+#include "core/stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace game {
+
+namespace {
+
+// Nearest-rank percentile on a sorted, non-empty sample set.
+double rank(const std::vector<double>& sorted, double pct) {
+    const double idx = std::ceil(pct / 100.0 * static_cast<double>(sorted.size())) - 1.0;
+    const std::size_t i = idx < 0.0 ? 0 : static_cast<std::size_t>(idx);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+} // namespace
+
+Percentiles summarize(std::vector<double>& samples) {
+    Percentiles out;
+    if (samples.empty()) return out;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    out.mean = sum / static_cast<double>(samples.size());
+    out.p50 = rank(samples, 50.0);
+    out.p90 = rank(samples, 90.0);
+    out.p99 = rank(samples, 99.0);
+    out.max = samples.back();
+    return out;
+}
+
+} // namespace game
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+struct Percentiles {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Summarises a set of samples; the input is sorted in place.
+Percentiles summarize(std::vector<double>& samples);
+
+} // namespace game
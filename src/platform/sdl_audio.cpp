@@ -0,0 +1,49 @@
+#include "platform/sdl_audio.hpp"
+
+#include <cstdint>
+
+namespace game {
+
+namespace {
+
+// Frames per callback: about 11 ms at 22050 Hz, short enough for effects to
+// feel immediate.
+constexpr Uint16 kCallbackFrames = 256;
+
+} // namespace
+
+SdlAudio::~SdlAudio() {
+    if (device_ == 0) return;
+    SDL_CloseAudioDevice(device_);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+bool SdlAudio::open(AudioMixer& mixer, std::string* error) {
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+        if (error) *error = std::string("SDL audio init failed: ") + SDL_GetError();
+        return false;
+    }
+    SDL_AudioSpec want{};
+    want.freq = static_cast<int>(mixer.sample_rate());
+    want.format = AUDIO_S16SYS;
+    want.channels = AudioMixer::kChannels;
+    want.samples = kCallbackFrames;
+    want.callback = &SdlAudio::callback;
+    want.userdata = &mixer;
+    device_ = SDL_OpenAudioDevice(nullptr, 0, &want, nullptr, 0);
+    if (device_ == 0) {
+        if (error) *error = std::string("SDL_OpenAudioDevice failed: ") + SDL_GetError();
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+    SDL_PauseAudioDevice(device_, 0);
+    return true;
+}
+
+void SDLCALL SdlAudio::callback(void* userdata, Uint8* stream, int len) {
+    auto* mixer = static_cast<AudioMixer*>(userdata);
+    const auto frames = static_cast<std::size_t>(len) / (sizeof(std::int16_t) * AudioMixer::kChannels);
+    mixer->mix(reinterpret_cast<std::int16_t*>(stream), frames);
+}
+
+} // namespace game
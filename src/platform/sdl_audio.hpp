@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <string>
+
+#include "audio/audio_mixer.hpp"
+
+namespace game {
+
+// Plays an AudioMixer on the default SDL audio device. SDL runs the callback
+// on its own thread and it only calls AudioMixer::mix(), so the device is
+// never locked from the game thread; sounds are triggered through the
+// mixer's command ring instead.
+class SdlAudio {
+public:
+    SdlAudio() = default;
+    ~SdlAudio();
+
+    SdlAudio(const SdlAudio&) = delete;
+    SdlAudio& operator=(const SdlAudio&) = delete;
+
+    // Opens a 16-bit stereo device at the mixer's rate (SDL converts if the
+    // hardware differs) and starts playback. `mixer` must outlive this.
+    bool open(AudioMixer& mixer, std::string* error);
+    bool ok() const { return device_ != 0; }
+
+private:
+    static void SDLCALL callback(void* userdata, Uint8* stream, int len);
+
+    SDL_AudioDeviceID device_ = 0;
+};
+
+} // namespace game
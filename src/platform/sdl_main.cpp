@@ -0,0 +1,432 @@
+// Windowed frontend: a vsync'd render loop that samples input, runs however
+// many fixed simulation ticks the elapsed time calls for, and draws the world
+// interpolated between the last two ticks.
+//
+//   sdl_game [--software] [--pack PATH] [--threads N] [--trace PATH] [--record PATH | --replay PATH [--uncapped]]
+//            [--stream PATH]
+//
+// Sprites and the level come from the asset pack (assets.pack in the
+// working directory by default); without one the built-in placeholder art and
+// demo level are used. Startup timings are printed once the first frame is up.
+// --stream plays a chunked level file (sdl_game_pack --level) instead, paging
+// its chunks in and out around the camera on a background thread; it cannot
+// be combined with recording or replays.
+//
+// --record saves every tick's input to a replay file on exit. --replay plays
+// one back instead of reading the keyboard, and with --uncapped simulates as
+// many ticks per frame as fit in the frame budget, so a long session replays
+// in seconds. Either way the run ends with a report of whether the state
+// checksums matched the recording.
+//
+// Holding Backspace rewinds the last few seconds of play, one tick per tick,
+// from snapshots the game keeps in a RewindBuffer. Releasing it resumes from
+// there. Rewind is off while recording, since the replay would no longer
+// match the session.
+//
+// Sound effects from the pack play on SDL's audio thread through an
+// AudioMixer; the game only queues commands for it and never locks the
+// device. Without a pack, or if no audio device opens, the game runs silent.
+//
+// The game runs on one thread unless --threads asks for more (0 = one per
+// hardware thread); extra threads run the data-parallel parts of the update
+// and render-prep stages on a JobSystem. SDL is only called from this thread.
+//
+// F3 toggles a frame-time graph of the last two seconds, split into the
+// input, update, collision, render-prep and present stages. F4 writes the
+// profiler's recent history as a Chrome trace (--trace PATH, default
+// sdl_game_trace.json), and so does exiting when --trace was given.
+
+#include <SDL.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "assets/asset_pack.hpp"
+#include "assets/game_assets.hpp"
+#include "audio/audio_mixer.hpp"
+#include "core/clock.hpp"
+#include "core/fixed_timestep.hpp"
+#include "core/frame_arena.hpp"
+#include "core/job_system.hpp"
+#include "core/profiler.hpp"
+#include "platform/sdl_audio.hpp"
+#include "platform/sdl_renderer.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "render/frame_graph.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "sim/level_streamer.hpp"
+#include "sim/levels.hpp"
+#include "sim/replay.hpp"
+#include "sim/rewind_buffer.hpp"
+#include "sim/world.hpp"
+
+namespace {
+
+constexpr int kWindowWidth = 640;
+constexpr int kWindowHeight = 360;
+constexpr double kTickRate = 120.0;
+constexpr std::uint32_t kActorSeed = 1;
+constexpr std::uint32_t kActorCount = 24;
+// Recordings reserve this much input up front so ticks never allocate.
+constexpr std::size_t kRecordReserveTicks = 60 * 60 * 120;
+// Wall-clock budget for simulation per frame in uncapped replays.
+constexpr std::int64_t kUncappedBudgetNs = 12'000'000;
+// Frame-time graph panel, in logical pixels, and the frame time it is scaled
+// around.
+constexpr float kGraphWidth = 240.0f;
+constexpr float kGraphHeight = 60.0f;
+constexpr double kGraphTargetMs = 1000.0 / 60.0;
+// Rewind keeps up to this many seconds of snapshots in this much memory.
+constexpr int kRewindSeconds = 5;
+constexpr std::size_t kRewindBudgetBytes = 32u << 20;
+// Rate of the sounds in the pack; SDL converts to the device's own.
+constexpr std::uint32_t kAudioRate = 22050;
+
+// Mixer clip indices of the sound effects, -1 where one is missing.
+struct SoundEffects {
+    int jump = -1;
+    int pickup = -1;
+    int hit = -1;
+};
+
+SoundEffects load_sound_effects(game::AssetPack& pack, game::AudioMixer& mixer) {
+    SoundEffects fx;
+    std::string error;
+    const struct {
+        const char* name;
+        int* index;
+    } sounds[] = {{"jump", &fx.jump}, {"pickup", &fx.pickup}, {"hit", &fx.hit}};
+    for (const auto& s : sounds) {
+        game::SoundClip clip;
+        if (!game::load_sound(pack, s.name, clip, &error) || (*s.index = mixer.add_clip(clip, &error)) < 0) {
+            std::fprintf(stderr, "sound %s: %s\n", s.name, error.c_str());
+        }
+    }
+    return fx;
+}
+
+game::InputState read_input() {
+    const Uint8* keys = SDL_GetKeyboardState(nullptr);
+    game::InputState input;
+    input.set(game::kButtonLeft, keys[SDL_SCANCODE_LEFT] || keys[SDL_SCANCODE_A]);
+    input.set(game::kButtonRight, keys[SDL_SCANCODE_RIGHT] || keys[SDL_SCANCODE_D]);
+    input.set(game::kButtonJump, keys[SDL_SCANCODE_SPACE] || keys[SDL_SCANCODE_UP] ||
+                                     keys[SDL_SCANCODE_W]);
+    return input;
+}
+
+double ms_between(std::uint64_t from_ns, std::uint64_t to_ns) {
+    return static_cast<double>(to_ns - from_ns) / 1e6;
+}
+
+void write_trace(const char* path) {
+    std::string error;
+    if (game::profile::write_chrome_trace(path, &error)) {
+        std::printf("wrote trace to %s\n", path);
+    } else {
+        std::fprintf(stderr, "%s\n", error.c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t start_ns = game::now_ns();
+    game::profile::set_thread_name("main");
+    bool software = false;
+    bool uncapped = false;
+    const char* pack_path = "assets.pack";
+    const char* record_path = nullptr;
+    const char* replay_path = nullptr;
+    const char* trace_path = nullptr;
+    const char* stream_path = nullptr;
+    int threads = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--software") == 0) software = true;
+        if (std::strcmp(argv[i], "--uncapped") == 0) uncapped = true;
+        if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc) pack_path = argv[++i];
+        if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) record_path = argv[++i];
+        if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replay_path = argv[++i];
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = std::atoi(argv[++i]);
+        if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_path = argv[++i];
+        if (std::strcmp(argv[i], "--stream") == 0 && i + 1 < argc) stream_path = argv[++i];
+    }
+    if (record_path && replay_path) {
+        std::fprintf(stderr, "--record and --replay cannot be combined\n");
+        return 1;
+    }
+    if (stream_path && (record_path || replay_path)) {
+        std::fprintf(stderr, "--stream cannot be combined with --record or --replay\n");
+        return 1;
+    }
+
+    game::Replay replay;
+    std::string error;
+    if (replay_path && !game::load_replay(replay_path, replay, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    game::LevelStreamer streamer;
+    if (stream_path && !streamer.open(stream_path, game::StreamConfig{}, kWindowWidth, kWindowHeight, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Window* window = SDL_CreateWindow("sdl_game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                          kWindowWidth * 2, kWindowHeight * 2, SDL_WINDOW_RESIZABLE);
+    if (!window) {
+        std::fprintf(stderr, "SDL_CreateWindow failed: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_Renderer* renderer = nullptr;
+    if (!software) renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if (!renderer) {
+        std::fprintf(stderr, "SDL_CreateRenderer failed: %s\n", SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    SDL_RenderSetLogicalSize(renderer, kWindowWidth, kWindowHeight);
+
+    const std::uint64_t window_ns = game::now_ns();
+
+    // The pack stays mapped for the whole run; sprites and the level are
+    // decoded from it up front, everything else on first use.
+    game::AssetPack pack;
+    game::SpriteRegistry sprites;
+    game::TileMap level;
+    const bool from_pack = pack.open(pack_path, &error) && game::load_sprite_registry(pack, sprites, &error) &&
+                           (stream_path || game::load_level(pack, "demo", level, &error));
+    if (!from_pack) {
+        std::fprintf(stderr, "using built-in assets: %s\n", error.c_str());
+        sprites = game::make_builtin_sprites();
+        level = game::make_demo_level();
+    }
+    if (stream_path) level = streamer.make_map();
+    const std::uint64_t assets_ns = game::now_ns();
+
+    if (!game::World::fits(level)) {
+        std::fprintf(stderr, "level is %dx%d tiles; this build's physics handles at most %d a side\n", level.width(),
+                     level.height(), game::World::kMaxLevelTiles);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
+    if (replay_path && (game::hash_level(level) != replay.level_hash ||
+                        replay.tick_rate != static_cast<std::uint32_t>(kTickRate))) {
+        std::fprintf(stderr, "%s was recorded on a different level or tick rate\n", replay_path);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+    if (record_path) {
+        replay.tick_rate = static_cast<std::uint32_t>(kTickRate);
+        replay.level_hash = game::hash_level(level);
+        replay.actor_seed = kActorSeed;
+        replay.actor_count = kActorCount;
+        replay.inputs.reserve(kRecordReserveTicks);
+    }
+
+    int exit_code = 0;
+    {
+        game::SdlRenderer backend(renderer, sprites);
+        if (!backend.ok()) exit_code = 1;
+
+        // The mixer is filled before the device starts calling it and
+        // outlives the device.
+        game::AudioMixer mixer(kAudioRate);
+        SoundEffects fx;
+        if (from_pack) fx = load_sound_effects(pack, mixer);
+        game::SdlAudio audio;
+        if (from_pack && !audio.open(mixer, &error)) std::fprintf(stderr, "running silent: %s\n", error.c_str());
+
+        std::unique_ptr<game::JobSystem> jobs;
+        if (threads != 1) jobs = std::make_unique<game::JobSystem>(threads);
+
+        game::World world(std::move(level), {48.0f, 200.0f});
+        world.set_job_system(jobs.get());
+        if (stream_path) {
+            // Actors are only placed on resident tiles, so page in the
+            // start of the level first.
+            const game::Camera start = game::Camera::follow(world.interpolated_player_pos(1.0f), kWindowWidth,
+                                                            kWindowHeight, world.map());
+            streamer.prime(world.map(), start.view());
+        }
+        if (replay_path) {
+            game::populate_actors(world, static_cast<int>(replay.actor_count), replay.actor_seed);
+        } else {
+            game::populate_actors(world, static_cast<int>(kActorCount), kActorSeed);
+        }
+        game::RewindBuffer rewind(kRewindBudgetBytes, static_cast<std::size_t>(kRewindSeconds * kTickRate));
+        rewind.capture(world);
+        game::ReplayPlayer player(replay);
+        const std::uint64_t replay_start_ns = game::now_ns();
+        game::FixedTimestep timestep(kTickRate);
+        game::RenderList render_list;
+        game::SpriteBatcher batcher;
+        game::FrameArena frame_arena;
+        game::FrameGraph frame_graph({"input", "update", "collision", "render-prep", "present"});
+        bool show_graph = false;
+        const float dt = static_cast<float>(timestep.dt());
+
+        const double counter_freq = static_cast<double>(SDL_GetPerformanceFrequency());
+        Uint64 last = SDL_GetPerformanceCounter();
+        Uint64 last_title = last;
+        bool running = exit_code == 0;
+        bool first_frame = true;
+        std::int64_t frame_begin_ns = game::now_ns();
+        while (running) {
+            {
+                GAME_PROFILE_SCOPE("input");
+                SDL_Event event;
+                while (SDL_PollEvent(&event)) {
+                    if (event.type == SDL_QUIT) running = false;
+                    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+                        backend.invalidate_tile_cache();
+                    }
+                    if (event.type != SDL_KEYDOWN) continue;
+                    if (event.key.keysym.sym == SDLK_ESCAPE) running = false;
+                    if (event.key.keysym.sym == SDLK_F3) show_graph = !show_graph;
+                    if (event.key.keysym.sym == SDLK_F4) write_trace(trace_path ? trace_path : "sdl_game_trace.json");
+                }
+            }
+
+            const Uint64 now = SDL_GetPerformanceCounter();
+            const double frame_seconds = static_cast<double>(now - last) / counter_freq;
+            last = now;
+
+            const std::uint32_t jumps = world.player_jumps();
+            const std::uint32_t pickups = world.pickups_collected();
+            const std::uint32_t hits = world.player_hits();
+            float alpha = 1.0f;
+            if (replay_path && uncapped) {
+                const std::int64_t budget_end = game::now_ns() + kUncappedBudgetNs;
+                while (!player.done() && game::now_ns() < budget_end) player.step(world);
+            } else if (replay_path) {
+                const int ticks = timestep.advance(frame_seconds);
+                for (int i = 0; i < ticks && !player.done(); ++i) player.step(world);
+                alpha = static_cast<float>(timestep.alpha());
+            } else {
+                // Input is sampled once per frame and held for every tick it produces.
+                game::InputState input;
+                {
+                    GAME_PROFILE_SCOPE("input");
+                    input = read_input();
+                }
+                const bool rewinding = !record_path && SDL_GetKeyboardState(nullptr)[SDL_SCANCODE_BACKSPACE];
+                const int ticks = timestep.advance(frame_seconds);
+                for (int i = 0; i < ticks; ++i) {
+                    if (rewinding) {
+                        if (rewind.size() > 1) rewind.restore(world, rewind.newest_tick() - 1);
+                        continue;
+                    }
+                    world.step(input, dt);
+                    if (record_path) {
+                        replay.record(input, world);
+                    } else {
+                        rewind.capture(world);
+                    }
+                }
+                alpha = static_cast<float>(timestep.alpha());
+            }
+            // At most one of each effect per frame, however many ticks ran,
+            // and none while rewinding takes the counters back.
+            if (audio.ok() && !(replay_path && uncapped)) {
+                if (world.player_jumps() > jumps) mixer.play(fx.jump, 0.6f);
+                if (world.pickups_collected() > pickups) mixer.play(fx.pickup, 0.8f);
+                if (world.player_hits() > hits) mixer.play(fx.hit, 0.8f);
+            }
+
+            const game::Camera camera = game::Camera::follow(world.interpolated_player_pos(alpha), kWindowWidth,
+                                                             kWindowHeight, world.map());
+            if (stream_path) {
+                GAME_PROFILE_SCOPE("stream");
+                streamer.update(world.map(), camera.view());
+            }
+            {
+                GAME_PROFILE_SCOPE("render-prep");
+                render_list.cache_tiles = backend.caches_tiles();
+                game::build_render_list(world, alpha, camera, sprites, render_list);
+                if (show_graph) {
+                    frame_graph.draw(render_list, 8.0f, kWindowHeight - kGraphHeight - 8.0f, kGraphWidth,
+                                     kGraphHeight, kGraphTargetMs);
+                }
+                batcher.build(render_list, frame_arena, jobs.get());
+            }
+            {
+                GAME_PROFILE_SCOPE("present");
+                backend.submit(render_list, batcher);
+            }
+            frame_arena.reset();
+            const std::int64_t frame_end_ns = game::now_ns();
+            frame_graph.add_frame(frame_begin_ns, frame_end_ns);
+            frame_begin_ns = frame_end_ns;
+
+            if (first_frame) {
+                const std::uint64_t frame_ns = game::now_ns();
+                std::printf("startup: window %.2f ms, assets %.2f ms (%s), first frame %.2f ms, total %.2f ms\n",
+                            ms_between(start_ns, window_ns), ms_between(window_ns, assets_ns),
+                            from_pack ? pack_path : "built-in", ms_between(assets_ns, frame_ns),
+                            ms_between(start_ns, frame_ns));
+                first_frame = false;
+            }
+
+            // Draw-call counters, refreshed in the title once a second.
+            if (static_cast<double>(now - last_title) / counter_freq >= 1.0) {
+                char title[128];
+                std::snprintf(title, sizeof title, "sdl_game - %u sprites, %u particles, %u batches, %zu tile chunks",
+                              batcher.stats().sprites, batcher.stats().particles, batcher.stats().batches,
+                              render_list.chunks.size());
+                SDL_SetWindowTitle(window, title);
+                last_title = now;
+            }
+
+            if (replay_path && player.done()) {
+                const game::ReplayResult& r = player.result();
+                const double ms = ms_between(replay_start_ns, game::now_ns());
+                std::printf("replay: %llu ticks in %.1f ms (%.1fx real time), %s\n",
+                            static_cast<unsigned long long>(r.ticks), ms,
+                            static_cast<double>(r.ticks) / kTickRate * 1000.0 / ms,
+                            r.matched() ? "checksums matched" : "DIVERGED");
+                if (!r.matched()) {
+                    std::printf("first mismatch after tick %lld\n", static_cast<long long>(r.diverged_at));
+                    exit_code = 1;
+                }
+                running = false;
+            }
+        }
+
+        if (trace_path) write_trace(trace_path);
+        if (record_path) {
+            replay.finish(world);
+            if (game::save_replay(record_path, replay, &error)) {
+                std::printf("recorded %zu ticks to %s\n", replay.inputs.size(), record_path);
+            } else {
+                std::fprintf(stderr, "%s\n", error.c_str());
+                exit_code = 1;
+            }
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return exit_code;
+}
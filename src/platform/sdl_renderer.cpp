@@ -0,0 +1,145 @@
+#include "platform/sdl_renderer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "core/profiler.hpp"
+
+// CMake checks this too when SDL2 ships a version file.
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "sdl_game needs SDL 2.0.18 or newer for SDL_RenderGeometry"
+#endif
+
+namespace game {
+
+namespace {
+
+constexpr int kChunkPixels = TileMap::kTileSize * TileChunk::kSize;
+constexpr int kChunkTiles = TileChunk::kSize * TileChunk::kSize;
+
+} // namespace
+
+SdlRenderer::SdlRenderer(SDL_Renderer* renderer, const SpriteRegistry& sprites) : renderer_(renderer) {
+    for (const TextureAtlas& atlas : sprites.atlases) {
+        SDL_Texture* tex = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                             atlas.width, atlas.height);
+        if (!tex) {
+            std::fprintf(stderr, "SDL_CreateTexture failed: %s\n", SDL_GetError());
+            ok_ = false;
+        } else {
+            SDL_UpdateTexture(tex, nullptr, atlas.pixels.data(), atlas.width * 4);
+            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        }
+        atlas_textures_.push_back(tex);
+    }
+
+    // Chunk textures are created on first use; the vertex scratch is sized
+    // for a full chunk up front so redraws never allocate.
+    caches_tiles_ = SDL_RenderTargetSupported(renderer_) == SDL_TRUE;
+    tile_frame_ = sprites.frame(kSpriteTileSolid);
+    chunk_vertices_.resize(static_cast<std::size_t>(kChunkTiles) * 4);
+    chunk_indices_.resize(static_cast<std::size_t>(kChunkTiles) * 6);
+    for (int i = 0; i < kChunkTiles; ++i) {
+        const int v = i * 4;
+        const int quad[6] = {v, v + 1, v + 2, v, v + 2, v + 3};
+        std::copy(quad, quad + 6, chunk_indices_.begin() + i * 6);
+    }
+}
+
+SdlRenderer::~SdlRenderer() {
+    for (SDL_Texture* tex : atlas_textures_) {
+        if (tex) SDL_DestroyTexture(tex);
+    }
+    for (SDL_Texture* tex : chunk_textures_) {
+        if (tex) SDL_DestroyTexture(tex);
+    }
+}
+
+void SdlRenderer::set_color(std::uint32_t rgba) {
+    SDL_SetRenderDrawColor(renderer_, static_cast<Uint8>(rgba >> 24), static_cast<Uint8>(rgba >> 16),
+                           static_cast<Uint8>(rgba >> 8), static_cast<Uint8>(rgba));
+}
+
+bool SdlRenderer::draw_chunk(int slot, const TileChunk& chunk) {
+    SDL_Texture*& target = chunk_textures_[slot];
+    if (!target) {
+        target = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, kChunkPixels,
+                                   kChunkPixels);
+        if (!target) return false;
+        SDL_SetTextureBlendMode(target, SDL_BLENDMODE_BLEND);
+    }
+    if (SDL_SetRenderTarget(renderer_, target) != 0) return false;
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+    SDL_RenderClear(renderer_);
+
+    const float ts = static_cast<float>(TileMap::kTileSize);
+    const SDL_Color white{255, 255, 255, 255};
+    const SpriteFrame& f = tile_frame_;
+    int quads = 0;
+    for (int ty = 0; ty < TileChunk::kSize; ++ty) {
+        const std::uint32_t row = chunk.solid_rows[static_cast<std::size_t>(ty)];
+        for (int tx = 0; tx < TileChunk::kSize; ++tx) {
+            if (!((row >> tx) & 1u)) continue;
+            const float x = static_cast<float>(tx) * ts;
+            const float y = static_cast<float>(ty) * ts;
+            SDL_Vertex* v = &chunk_vertices_[static_cast<std::size_t>(quads++) * 4];
+            v[0] = {{x, y}, white, {f.u0, f.v0}};
+            v[1] = {{x + ts, y}, white, {f.u1, f.v0}};
+            v[2] = {{x + ts, y + ts}, white, {f.u1, f.v1}};
+            v[3] = {{x, y + ts}, white, {f.u0, f.v1}};
+        }
+    }
+    SDL_Texture* atlas = f.atlas < atlas_textures_.size() ? atlas_textures_[f.atlas] : nullptr;
+    SDL_RenderGeometry(renderer_, atlas, chunk_vertices_.data(), quads * 4, chunk_indices_.data(), quads * 6);
+    SDL_SetRenderTarget(renderer_, nullptr);
+    return true;
+}
+
+void SdlRenderer::submit(const RenderList& list, const SpriteBatcher& batcher) {
+    // Bring every visible chunk's texture up to date before drawing the
+    // frame, so render targets are not switched in the middle of it.
+    ++frame_;
+    chunk_redraws_ = 0;
+    int slots[RenderList::kMaxChunks];
+    const std::size_t chunks = caches_tiles_ ? list.chunks.size() : 0;
+    for (std::size_t i = 0; i < chunks; ++i) {
+        const TileChunkCache::Lookup lookup = chunk_cache_.acquire(list.chunks[i].chunk, frame_);
+        slots[i] = lookup.slot;
+        if (!lookup.redraw) continue;
+        if (!draw_chunk(lookup.slot, *list.chunks[i].chunk)) {
+            std::fprintf(stderr, "tile chunk cache disabled: %s\n", SDL_GetError());
+            caches_tiles_ = false;
+            break;
+        }
+        ++chunk_redraws_;
+    }
+
+    set_color(list.clear_rgba);
+    SDL_RenderClear(renderer_);
+
+    // Tiles are the back layer, so their chunks go down before any batch.
+    if (caches_tiles_) {
+        for (std::size_t i = 0; i < chunks; ++i) {
+            const Aabb& d = list.chunks[i].dst;
+            const SDL_FRect dst{d.x, d.y, d.w, d.h};
+            SDL_RenderCopyF(renderer_, chunk_textures_[slots[i]], nullptr, &dst);
+        }
+    }
+
+    for (const SpriteBatch& batch : batcher.batches()) {
+        SDL_Texture* tex = batch.atlas < atlas_textures_.size() ? atlas_textures_[batch.atlas] : nullptr;
+        SDL_RenderGeometry(renderer_, tex, reinterpret_cast<const SDL_Vertex*>(batch.vertices), batch.vertex_count,
+                           batch.indices, batch.index_count);
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+    for (const DrawRect& d : list.rects) {
+        set_color(d.rgba);
+        const SDL_FRect r{d.rect.x, d.rect.y, d.rect.w, d.rect.h};
+        SDL_RenderFillRectF(renderer_, &r);
+    }
+    GAME_PROFILE_SCOPE("flip");
+    SDL_RenderPresent(renderer_);
+}
+
+} // namespace game
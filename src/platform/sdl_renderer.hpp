@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "render/atlas.hpp"
+#include "render/render_list.hpp"
+#include "render/sprite_batcher.hpp"
+#include "render/tile_chunk_cache.hpp"
+
+namespace game {
+
+// Owns the SDL textures for the sprite atlases and submits prepared frames.
+// Sprites go out as one SDL_RenderGeometry call per batch, which every SDL
+// renderer supports, including the software one.
+//
+// When the renderer supports render targets, static tiles are kept
+// pre-rendered per chunk in TileChunkCache::kSlots target textures, so a
+// frame draws a handful of chunk quads instead of every visible tile.
+class SdlRenderer {
+public:
+    SdlRenderer(SDL_Renderer* renderer, const SpriteRegistry& sprites);
+    ~SdlRenderer();
+
+    SdlRenderer(const SdlRenderer&) = delete;
+    SdlRenderer& operator=(const SdlRenderer&) = delete;
+
+    // False if an atlas texture could not be created.
+    bool ok() const { return ok_; }
+
+    // Whether build_render_list should emit tile chunks (RenderList::cache_tiles).
+    bool caches_tiles() const { return caches_tiles_; }
+    // Drops every cached chunk. Call it after replacing the level and when
+    // SDL reports that render targets were reset.
+    void invalidate_tile_cache() { chunk_cache_.clear(); }
+    // Chunks re-rendered into their textures by the last submit().
+    std::uint32_t chunk_redraws() const { return chunk_redraws_; }
+
+    void submit(const RenderList& list, const SpriteBatcher& batcher);
+
+private:
+    void set_color(std::uint32_t rgba);
+    // Re-renders `chunk`'s tiles into the texture of cache slot `slot`.
+    bool draw_chunk(int slot, const TileChunk& chunk);
+
+    SDL_Renderer* renderer_;
+    std::vector<SDL_Texture*> atlas_textures_;
+    bool ok_ = true;
+
+    bool caches_tiles_ = false;
+    SpriteFrame tile_frame_;
+    TileChunkCache chunk_cache_;
+    SDL_Texture* chunk_textures_[TileChunkCache::kSlots] = {};
+    std::vector<SDL_Vertex> chunk_vertices_;
+    std::vector<int> chunk_indices_;
+    std::uint64_t frame_ = 0;
+    std::uint32_t chunk_redraws_ = 0;
+};
+
+} // namespace game
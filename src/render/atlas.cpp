@@ -0,0 +1,72 @@
+#include "render/atlas.hpp"
+
+#include <utility>
+
+namespace game {
+
+namespace {
+
+constexpr std::uint32_t rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255) {
+    return static_cast<std::uint32_t>(r) | static_cast<std::uint32_t>(g) << 8 |
+           static_cast<std::uint32_t>(b) << 16 | static_cast<std::uint32_t>(a) << 24;
+}
+
+// Fills a w*h cell at (x, y) with `fill` and a one-pixel `edge` border.
+void paint_box(TextureAtlas& atlas, int x, int y, int w, int h, std::uint32_t fill, std::uint32_t edge) {
+    for (int py = y; py < y + h; ++py) {
+        for (int px = x; px < x + w; ++px) {
+            const bool border = px == x || py == y || px == x + w - 1 || py == y + h - 1;
+            atlas.pixels[static_cast<std::size_t>(py) * atlas.width + px] = border ? edge : fill;
+        }
+    }
+}
+
+SpriteFrame frame_for(std::uint16_t page, const TextureAtlas& atlas, int x, int y, int w, int h) {
+    const float iw = 1.0f / static_cast<float>(atlas.width);
+    const float ih = 1.0f / static_cast<float>(atlas.height);
+    return {page, x * iw, y * ih, (x + w) * iw, (y + h) * ih};
+}
+
+} // namespace
+
+const char* sprite_name(SpriteId id) {
+    switch (id) {
+    case kSpriteTileSolid: return "tile_solid";
+    case kSpritePlayer: return "player";
+    case kSpriteEnemy: return "enemy";
+    case kSpriteProjectile: return "projectile";
+    case kSpritePickup: return "pickup";
+    case kSpriteCount: break;
+    }
+    return "";
+}
+
+SpriteRegistry make_builtin_sprites() {
+    SpriteRegistry reg;
+
+    TextureAtlas tiles;
+    tiles.width = 64;
+    tiles.height = 64;
+    tiles.pixels.assign(static_cast<std::size_t>(tiles.width) * tiles.height, 0);
+    paint_box(tiles, 0, 0, 16, 16, rgba(90, 110, 140), rgba(60, 74, 98));
+    reg.frames[kSpriteTileSolid] = frame_for(0, tiles, 0, 0, 16, 16);
+    reg.atlases.push_back(std::move(tiles));
+
+    TextureAtlas actors;
+    actors.width = 64;
+    actors.height = 64;
+    actors.pixels.assign(static_cast<std::size_t>(actors.width) * actors.height, 0);
+    paint_box(actors, 0, 0, 16, 16, rgba(240, 200, 80), rgba(160, 120, 40));
+    paint_box(actors, 16, 0, 16, 16, rgba(208, 72, 72), rgba(120, 30, 30));
+    paint_box(actors, 32, 0, 8, 8, rgba(255, 255, 255), rgba(200, 200, 220));
+    paint_box(actors, 48, 0, 8, 8, rgba(80, 208, 112), rgba(30, 120, 60));
+    reg.frames[kSpritePlayer] = frame_for(1, actors, 0, 0, 16, 16);
+    reg.frames[kSpriteEnemy] = frame_for(1, actors, 16, 0, 16, 16);
+    reg.frames[kSpriteProjectile] = frame_for(1, actors, 32, 0, 8, 8);
+    reg.frames[kSpritePickup] = frame_for(1, actors, 48, 0, 8, 8);
+    reg.atlases.push_back(std::move(actors));
+
+    return reg;
+}
+
+} // namespace game
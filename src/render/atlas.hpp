@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+enum SpriteId : std::uint16_t {
+    kSpriteTileSolid,
+    kSpritePlayer,
+    kSpriteEnemy,
+    kSpriteProjectile,
+    kSpritePickup,
+    kSpriteCount,
+};
+
+// Name a sprite is stored under in asset packs.
+const char* sprite_name(SpriteId id);
+
+// RGBA8 pixels (R in the lowest byte, i.e. SDL_PIXELFORMAT_RGBA32) for one
+// texture page.
+struct TextureAtlas {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint32_t> pixels;
+};
+
+// Where a sprite lives: which atlas page and its normalised UV rectangle.
+struct SpriteFrame {
+    std::uint16_t atlas = 0;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+};
+
+// All texture pages plus the frame for every SpriteId.
+struct SpriteRegistry {
+    std::vector<TextureAtlas> atlases;
+    std::array<SpriteFrame, kSpriteCount> frames{};
+
+    const SpriteFrame& frame(SpriteId id) const { return frames[id]; }
+};
+
+// Procedurally painted placeholder art: one page for tiles, one for actors.
+SpriteRegistry make_builtin_sprites();
+
+} // namespace game
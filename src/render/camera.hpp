@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/math.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// View rectangle in world pixels.
+struct Camera {
+    float x = 0.0f;
+    float y = 0.0f;
+    float w = 0.0f;
+    float h = 0.0f;
+
+    Aabb view() const { return {x, y, w, h}; }
+
+    // Centres a w*h view on target, clamped so it never shows past the map.
+    static Camera follow(Vec2 target, float w, float h, const TileMap& map) {
+        const float max_x = static_cast<float>(map.width() * TileMap::kTileSize) - w;
+        const float max_y = static_cast<float>(map.height() * TileMap::kTileSize) - h;
+        Camera c;
+        c.w = w;
+        c.h = h;
+        c.x = clampf(target.x - w * 0.5f, 0.0f, max_x > 0.0f ? max_x : 0.0f);
+        c.y = clampf(target.y - h * 0.5f, 0.0f, max_y > 0.0f ? max_y : 0.0f);
+        return c;
+    }
+};
+
+} // namespace game
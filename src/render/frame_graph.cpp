@@ -0,0 +1,87 @@
+#include "render/frame_graph.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/profiler.hpp"
+
+namespace game {
+
+namespace {
+
+constexpr std::uint32_t kStageColors[FrameGraph::kMaxStages] = {
+    0xe0404cffu, 0xe0c040ffu, 0x50c050ffu, 0x40c0d0ffu, 0x5070e0ffu, 0xc050c0ffu,
+};
+constexpr std::uint32_t kOtherColor = 0x808080ffu;
+constexpr std::uint32_t kPanelColor = 0x00000090u;
+constexpr std::uint32_t kTargetColor = 0xffffffa0u;
+
+struct StageSums {
+    const char* const* names;
+    int count;
+    std::int64_t begin_ns;
+    std::int64_t end_ns;
+    std::int64_t* sums;
+};
+
+} // namespace
+
+FrameGraph::FrameGraph(std::initializer_list<const char*> stages) {
+    for (const char* name : stages) {
+        if (stage_count_ == kMaxStages) break;
+        stages_[stage_count_++] = name;
+    }
+}
+
+void FrameGraph::add_frame(std::int64_t begin_ns, std::int64_t end_ns) {
+    Frame& f = frames_[next_];
+    f = {};
+    f.total_ns = end_ns - begin_ns;
+    StageSums ctx{stages_, stage_count_, begin_ns, end_ns, f.stage_ns};
+    profile::visit_thread_events(
+        begin_ns,
+        [](const profile::Event& e, void* p) {
+            const auto& c = *static_cast<const StageSums*>(p);
+            if (e.begin_ns < c.begin_ns || e.end_ns > c.end_ns) return;
+            for (int s = 0; s < c.count; ++s) {
+                if (std::strcmp(e.name, c.names[s]) == 0) {
+                    c.sums[s] += e.end_ns - e.begin_ns;
+                    return;
+                }
+            }
+        },
+        &ctx);
+    next_ = (next_ + 1) % kFrames;
+    count_ = std::min(count_ + 1, kFrames);
+}
+
+void FrameGraph::draw(RenderList& out, float x, float y, float w, float h, double target_ms) const {
+    const float px_per_ns = static_cast<float>(h / (target_ms * 2.0e6));
+    const float bar_w = w / static_cast<float>(kFrames);
+    const float bottom = y + h;
+    out.rects.push({{x, y, w, h}, kPanelColor});
+
+    // Oldest frame on the left; bars taller than the panel are clipped.
+    for (int k = 0; k < count_; ++k) {
+        const Frame& f = frames_[(next_ - count_ + k + kFrames) % kFrames];
+        const float bx = x + static_cast<float>(kFrames - count_ + k) * bar_w;
+        float top = bottom;
+        std::int64_t staged_ns = 0;
+        auto segment = [&](std::int64_t ns, std::uint32_t rgba) {
+            const float seg = std::min(static_cast<float>(ns) * px_per_ns, top - y);
+            if (seg <= 0.0f) return;
+            top -= seg;
+            out.rects.push({{bx, top, bar_w, seg}, rgba});
+        };
+        for (int s = 0; s < stage_count_; ++s) {
+            segment(f.stage_ns[s], kStageColors[s]);
+            staged_ns += f.stage_ns[s];
+        }
+        segment(f.total_ns - staged_ns, kOtherColor);
+    }
+
+    out.rects.push({{x, bottom - h * 0.5f, w, 1.0f}, kTargetColor});
+    out.rects.push({{x, y, w, 1.0f}, kTargetColor});
+}
+
+} // namespace game
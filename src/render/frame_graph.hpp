@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "render/render_list.hpp"
+
+namespace game {
+
+// Rolling frame-time graph for the debug overlay: one bar per recent frame,
+// as tall as the frame took, split into coloured segments for the named
+// stages and grey for the rest.
+//
+// Stage times come from the profiler: each frame sums the calling thread's
+// scopes with a stage's name, at any depth, so stages must not nest inside
+// one another. In release-lite builds the bars are all grey.
+class FrameGraph {
+public:
+    static constexpr int kFrames = 120;
+    static constexpr int kMaxStages = 6;
+
+    // Stages in colour order: red, yellow, green, cyan, blue, magenta.
+    FrameGraph(std::initializer_list<const char*> stages);
+
+    // Records the frame that ran from begin_ns to end_ns. Call it on the
+    // thread that recorded the stage scopes.
+    void add_frame(std::int64_t begin_ns, std::int64_t end_ns);
+
+    // Appends the graph to out.rects: a w x h panel at (x, y) in screen
+    // pixels, scaled so target_ms is half its height, with marks at 1x and
+    // 2x target_ms.
+    void draw(RenderList& out, float x, float y, float w, float h, double target_ms) const;
+
+private:
+    struct Frame {
+        std::int64_t total_ns = 0;
+        std::int64_t stage_ns[kMaxStages] = {};
+    };
+
+    const char* stages_[kMaxStages] = {};
+    int stage_count_ = 0;
+    Frame frames_[kFrames];
+    int next_ = 0;
+    int count_ = 0;
+};
+
+} // namespace game
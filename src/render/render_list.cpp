@@ -0,0 +1,113 @@
+#include "render/render_list.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/profiler.hpp"
+#include "sim/world.hpp"
+
+namespace game {
+
+namespace {
+
+constexpr std::uint32_t kBackground = 0x181a26ffu;
+constexpr float kSparkSize = 2.0f;
+
+SpriteId actor_sprite(ActorKind kind) {
+    switch (kind) {
+    case ActorKind::Player: return kSpritePlayer;
+    case ActorKind::Enemy: return kSpriteEnemy;
+    case ActorKind::Projectile: return kSpriteProjectile;
+    case ActorKind::Pickup: return kSpritePickup;
+    }
+    return kSpriteEnemy;
+}
+
+RenderLayer actor_layer(ActorKind kind) {
+    switch (kind) {
+    case ActorKind::Player: return kLayerPlayer;
+    case ActorKind::Pickup: return kLayerItems;
+    default: return kLayerActors;
+    }
+}
+
+Aabb actor_box(const ActorStore& actors, std::uint32_t i, float alpha) {
+    return {lerp(to_float(actors.prev_x[i]), to_float(actors.x[i]), alpha),
+            lerp(to_float(actors.prev_y[i]), to_float(actors.y[i]), alpha), to_float(actors.w[i]),
+            to_float(actors.h[i])};
+}
+
+bool chunk_has_tiles(const TileChunk& chunk) {
+    std::uint32_t any = 0;
+    for (std::uint32_t row : chunk.solid_rows) any |= row;
+    return any != 0;
+}
+
+// Inclusive range of grid cells `cell` pixels wide that [lo, hi] touches,
+// clamped to [0, count).
+void cell_range(float lo, float hi, float cell, int count, int& first, int& last) {
+    first = std::max(static_cast<int>(std::floor(lo / cell)), 0);
+    last = std::min(static_cast<int>(std::floor(hi / cell)), count - 1);
+}
+
+void emit_tile_sprites(const TileMap& map, const Camera& camera, const SpriteRegistry& sprites, RenderList& out) {
+    const float ts = static_cast<float>(TileMap::kTileSize);
+    const SpriteFrame& tile_frame = sprites.frame(kSpriteTileSolid);
+    int tx0, tx1, ty0, ty1;
+    cell_range(camera.x, camera.x + camera.w, ts, map.width(), tx0, tx1);
+    cell_range(camera.y, camera.y + camera.h, ts, map.height(), ty0, ty1);
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            if (!map.solid(tx, ty) || !map.resident(tx >> TileChunk::kShift, ty >> TileChunk::kShift)) continue;
+            out.sprites.push({{tx * ts - camera.x, ty * ts - camera.y, ts, ts}, tile_frame, 0xffffffffu,
+                              kLayerTiles});
+        }
+    }
+}
+
+void emit_tile_chunks(const TileMap& map, const Camera& camera, RenderList& out) {
+    const float cs = static_cast<float>(TileMap::kTileSize * TileChunk::kSize);
+    int cx0, cx1, cy0, cy1;
+    cell_range(camera.x, camera.x + camera.w, cs, map.chunks_x(), cx0, cx1);
+    cell_range(camera.y, camera.y + camera.h, cs, map.chunks_y(), cy0, cy1);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const TileChunk& chunk = map.chunk(cx, cy);
+            if (!map.resident(cx, cy) || !chunk_has_tiles(chunk)) continue;
+            out.chunks.push({{cx * cs - camera.x, cy * cs - camera.y, cs, cs}, &chunk});
+        }
+    }
+}
+
+} // namespace
+
+void build_render_list(const World& world, float alpha, const Camera& camera, const SpriteRegistry& sprites,
+                       RenderList& out) {
+    GAME_PROFILE_SCOPE("render list");
+    out.clear();
+    out.clear_rgba = kBackground;
+
+    if (out.cache_tiles) {
+        emit_tile_chunks(world.map(), camera, out);
+    } else {
+        emit_tile_sprites(world.map(), camera, sprites, out);
+    }
+
+    // Actors: the grid holds them at their current positions and each moves
+    // less than a tile per tick, so a query a tile wider than the view finds
+    // every one whose interpolated box can be visible.
+    const ActorStore& actors = world.actors();
+    const Aabb view = camera.view();
+    const float ts = static_cast<float>(TileMap::kTileSize);
+    const Aabb reach{view.x - ts, view.y - ts, view.w + 2.0f * ts, view.h + 2.0f * ts};
+    world.grid().query(reach, [&](std::uint32_t i) {
+        const Aabb box = actor_box(actors, i, alpha);
+        if (!overlaps(box, view)) return;
+        out.sprites.push({{box.x - camera.x, box.y - camera.y, box.w, box.h},
+                          sprites.frame(actor_sprite(actors.kind[i])), 0xffffffffu, actor_layer(actors.kind[i])});
+    });
+
+    out.particles = {&world.particles(), alpha, view, sprites.frame(kSpriteProjectile), kSparkSize, kLayerActors};
+}
+
+} // namespace game
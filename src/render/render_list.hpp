@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/math.hpp"
+#include "core/pool.hpp"
+#include "render/atlas.hpp"
+#include "render/camera.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+class ParticleSystem;
+class World;
+
+// Draw order from back to front.
+enum RenderLayer : std::uint8_t {
+    kLayerTiles,
+    kLayerItems,
+    kLayerActors,
+    kLayerPlayer,
+    kLayerOverlay,
+};
+
+// A textured quad in screen pixels. `frame` says which atlas page and UVs to
+// sample; rgba (0xRRGGBBAA) tints it.
+struct Sprite {
+    Aabb dst;
+    SpriteFrame frame;
+    std::uint32_t rgba = 0xffffffffu;
+    std::uint8_t layer = 0;
+};
+
+// A solid rectangle in screen pixels; colour is 0xRRGGBBAA. Used for debug
+// overlays, drawn after all sprites.
+struct DrawRect {
+    Aabb rect;
+    std::uint32_t rgba = 0;
+};
+
+// A block of static tiles drawn as one quad: the backend keeps each chunk
+// pre-rendered in a texture and redraws it only when the chunk's revision
+// changes. dst is in screen pixels.
+struct ChunkDraw {
+    Aabb dst;
+    const TileChunk* chunk = nullptr;
+};
+
+// Every live particle of a system as a `size`-pixel square of `frame`, tinted
+// by the particle's colour and interpolated alpha of the way from the
+// previous tick. Not expanded into sprites: SpriteBatcher culls it to `view`
+// (world pixels, whose corner is the screen origin) and writes the quads
+// straight into one batch on `layer`.
+struct ParticleDraw {
+    const ParticleSystem* particles = nullptr;
+    float alpha = 1.0f;
+    Aabb view;
+    SpriteFrame frame;
+    float size = 0.0f;
+    std::uint8_t layer = 0;
+};
+
+// Backend-agnostic description of one frame. Building it is the render-prep
+// stage; the SDL frontend only walks the list and submits it.
+//
+// Commands live in fixed pools so building a frame never allocates. A full
+// pool drops further commands and counts them in dropped().
+struct RenderList {
+    static constexpr std::size_t kMaxSprites = 1u << 15;
+    static constexpr std::size_t kMaxRects = 1024;
+    static constexpr std::size_t kMaxChunks = 64;
+
+    // Set by backends that cache tile chunks: tiles are then emitted as
+    // `chunks`, drawn before every sprite, instead of one sprite per tile.
+    bool cache_tiles = false;
+
+    std::uint32_t clear_rgba = 0;
+    Pool<ChunkDraw> chunks{kMaxChunks};
+    Pool<Sprite> sprites{kMaxSprites};
+    Pool<DrawRect> rects{kMaxRects};
+    ParticleDraw particles;
+
+    void clear() {
+        chunks.clear();
+        sprites.clear();
+        rects.clear();
+        particles = {};
+    }
+};
+
+// Culls the world to the camera and emits everything visible, with actors
+// interpolated alpha of the way from the previous tick to the current one.
+// Actors are found through the world's broad-phase grid, so the cost follows
+// what is on screen rather than the level's actor count. Particles are
+// passed on whole as `particles` for the batcher to cull.
+void build_render_list(const World& world, float alpha, const Camera& camera, const SpriteRegistry& sprites,
+                       RenderList& out);
+
+} // namespace game
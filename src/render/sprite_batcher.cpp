@@ -0,0 +1,230 @@
+#include "render/sprite_batcher.hpp"
+
+#include <cstring>
+
+#include "core/job_system.hpp"
+#include "core/profiler.hpp"
+#include "core/radix_sort.hpp"
+#include "sim/particle_system.hpp"
+
+namespace game {
+
+namespace {
+
+// Top 24 bits of a float's bit pattern, adjusted so they order like the
+// value: positives get the sign bit set, negatives have every bit flipped.
+std::uint32_t y_order(float y) {
+    std::uint32_t u;
+    std::memcpy(&u, &y, sizeof u);
+    u ^= (u >> 31) != 0 ? 0xffffffffu : 0x80000000u;
+    return u >> 8;
+}
+
+// [layer:8][atlas:16][bottom edge:24][submission index:16] so sorting groups
+// by layer, then atlas, draws lower sprites over higher ones within a group,
+// and keeps submission order among sprites on the same line.
+std::uint64_t sort_key(const Sprite& s, std::uint32_t index) {
+    return static_cast<std::uint64_t>(s.layer) << 56 | static_cast<std::uint64_t>(s.frame.atlas) << 40 |
+           static_cast<std::uint64_t>(y_order(s.dst.y + s.dst.h)) << 16 | index;
+}
+
+std::uint32_t group_of(std::uint64_t key) { return static_cast<std::uint32_t>(key >> 40); }
+std::uint32_t sprite_of(std::uint64_t key) { return static_cast<std::uint32_t>(key & 0xffff); }
+
+// Minimum sprites per job when writing quads in parallel.
+constexpr std::uint32_t kQuadGrain = 2048;
+// Particles are culled in fixed ranges of about this many, so the output
+// order does not depend on the thread count.
+constexpr std::uint32_t kParticleRange = 2048;
+constexpr std::uint32_t kMaxParticleRanges = 64;
+
+} // namespace
+
+void SpriteBatcher::build(const Sprite* sprites, std::size_t count, FrameArena& arena, JobSystem* jobs) {
+    GAME_PROFILE_SCOPE("batch sprites");
+    batches_ = {};
+    stats_ = {};
+    const std::size_t n = count < kMaxSprites ? count : kMaxSprites;
+    stats_.dropped = static_cast<std::uint32_t>(count - n);
+    if (n == 0) return;
+
+    std::uint64_t* keys = arena.alloc_array<std::uint64_t>(n);
+    for (std::size_t i = 0; i < n; ++i) keys[i] = sort_key(sprites[i], static_cast<std::uint32_t>(i));
+    radix_sort(keys, arena.alloc_array<std::uint64_t>(n), n);
+
+    std::size_t groups = 1;
+    for (std::size_t i = 1; i < n; ++i) groups += group_of(keys[i]) != group_of(keys[i - 1]);
+    SpriteBatch* batches = arena.alloc_array<SpriteBatch>(groups);
+    SpriteVertex* vertices = arena.alloc_array<SpriteVertex>(n * 4);
+    int* indices = arena.alloc_array<int>(n * 6);
+    // First sorted position of the batch each sprite lands in; indices are
+    // relative to it.
+    std::uint32_t* batch_start = arena.alloc_array<std::uint32_t>(n);
+
+    std::size_t begin = 0;
+    while (begin < n) {
+        std::size_t end = begin + 1;
+        while (end < n && group_of(keys[end]) == group_of(keys[begin])) ++end;
+
+        SpriteBatch batch;
+        batch.layer = static_cast<std::uint8_t>(keys[begin] >> 56);
+        batch.atlas = static_cast<std::uint16_t>(keys[begin] >> 40);
+        batch.vertices = vertices + begin * 4;
+        batch.indices = indices + begin * 6;
+        batch.sprite_count = static_cast<int>(end - begin);
+        batch.vertex_count = batch.sprite_count * 4;
+        batch.index_count = batch.sprite_count * 6;
+        batches[batches_.count++] = batch;
+        for (std::size_t k = begin; k < end; ++k) batch_start[k] = static_cast<std::uint32_t>(begin);
+        begin = end;
+    }
+    batches_.items = batches;
+
+    parallel_for(jobs, static_cast<std::uint32_t>(n), kQuadGrain, [=](std::uint32_t first, std::uint32_t last) {
+        for (std::uint32_t k = first; k < last; ++k) {
+            const Sprite& s = sprites[sprite_of(keys[k])];
+            const std::uint8_t r = static_cast<std::uint8_t>(s.rgba >> 24);
+            const std::uint8_t g = static_cast<std::uint8_t>(s.rgba >> 16);
+            const std::uint8_t b = static_cast<std::uint8_t>(s.rgba >> 8);
+            const std::uint8_t a = static_cast<std::uint8_t>(s.rgba);
+            const float x0 = s.dst.x, y0 = s.dst.y, x1 = s.dst.x + s.dst.w, y1 = s.dst.y + s.dst.h;
+            const int base = static_cast<int>((k - batch_start[k]) * 4);
+            SpriteVertex* v = vertices + static_cast<std::size_t>(k) * 4;
+            int* idx = indices + static_cast<std::size_t>(k) * 6;
+            v[0] = {x0, y0, r, g, b, a, s.frame.u0, s.frame.v0};
+            v[1] = {x1, y0, r, g, b, a, s.frame.u1, s.frame.v0};
+            v[2] = {x1, y1, r, g, b, a, s.frame.u1, s.frame.v1};
+            v[3] = {x0, y1, r, g, b, a, s.frame.u0, s.frame.v1};
+            idx[0] = base;
+            idx[1] = base + 1;
+            idx[2] = base + 2;
+            idx[3] = base;
+            idx[4] = base + 2;
+            idx[5] = base + 3;
+        }
+    });
+
+    stats_.sprites = static_cast<std::uint32_t>(n);
+    stats_.batches = static_cast<std::uint32_t>(batches_.count);
+}
+
+void SpriteBatcher::build(const RenderList& list, FrameArena& arena, JobSystem* jobs) {
+    build(list.sprites, arena, jobs);
+    SpriteBatch particles;
+    if (!list.particles.particles || !build_particles(list.particles, arena, jobs, particles)) return;
+
+    // Copy the sprite batches with the particle batch after the last one of
+    // its layer (batches are already in layer order).
+    const std::size_t count = batches_.count;
+    SpriteBatch* batches = arena.alloc_array<SpriteBatch>(count + 1);
+    std::size_t at = 0;
+    while (at < count && batches_.items[at].layer <= particles.layer) ++at;
+    for (std::size_t i = 0; i < at; ++i) batches[i] = batches_.items[i];
+    batches[at] = particles;
+    for (std::size_t i = at; i < count; ++i) batches[i + 1] = batches_.items[i];
+    batches_ = {batches, count + 1};
+    stats_.batches = static_cast<std::uint32_t>(batches_.count);
+}
+
+bool SpriteBatcher::build_particles(const ParticleDraw& draw, FrameArena& arena, JobSystem* jobs, SpriteBatch& out) {
+    GAME_PROFILE_SCOPE("batch particles");
+    const ParticleSystem& ps = *draw.particles;
+    const auto n = static_cast<std::uint32_t>(ps.size());
+    if (n == 0) return false;
+
+    // Screen-space corner of particle i's quad, and whether it is visible.
+    // Both passes below use this, so they agree on every particle. The tests
+    // are combined with & rather than &&: the counting pass then compiles to
+    // straight vector code instead of four branches per particle, which
+    // mispredict whenever particles straddle the view edges.
+    const float* x = ps.x();
+    const float* y = ps.y();
+    const float* prev_x = ps.prev_x();
+    const float* prev_y = ps.prev_y();
+    const float alpha = draw.alpha;
+    const float size = draw.size;
+    const float ox = draw.view.x + size * 0.5f;
+    const float oy = draw.view.y + size * 0.5f;
+    const float w = draw.view.w;
+    const float h = draw.view.h;
+    auto corner = [=](std::uint32_t i, float& sx, float& sy) -> bool {
+        sx = lerp(prev_x[i], x[i], alpha) - ox;
+        sy = lerp(prev_y[i], y[i], alpha) - oy;
+        return (sx < w) & (sx + size > 0.0f) & (sy < h) & (sy + size > 0.0f);
+    };
+
+    // Count the visible particles per range, then write each range's quads
+    // at its offset, so ranges run in parallel yet land in particle order.
+    std::uint32_t ranges = (n + kParticleRange - 1) / kParticleRange;
+    if (ranges > kMaxParticleRanges) ranges = kMaxParticleRanges;
+    auto range_begin = [=](std::uint32_t r) {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(n) * r / ranges);
+    };
+    std::uint32_t offsets[kMaxParticleRanges + 1] = {};
+    parallel_for(jobs, ranges, 1, [&](std::uint32_t first, std::uint32_t last) {
+        for (std::uint32_t r = first; r < last; ++r) {
+            std::uint32_t visible = 0;
+            for (std::uint32_t i = range_begin(r); i < range_begin(r + 1); ++i) {
+                float sx, sy;
+                visible += corner(i, sx, sy) ? 1u : 0u;
+            }
+            offsets[r + 1] = visible;
+        }
+    });
+    for (std::uint32_t r = 0; r < ranges; ++r) offsets[r + 1] += offsets[r];
+    const std::uint32_t visible = offsets[ranges];
+    if (visible == 0) return false;
+
+    // Quad k's indices are always 4k + {0, 1, 2, 0, 2, 3}; the table only
+    // grows when the particle capacity does.
+    if (particle_indices_.size() < ps.capacity() * 6) {
+        const std::size_t quads = particle_indices_.size() / 6;
+        particle_indices_.resize(ps.capacity() * 6);
+        for (std::size_t k = quads; k < ps.capacity(); ++k) {
+            const int base = static_cast<int>(k * 4);
+            int* idx = &particle_indices_[k * 6];
+            idx[0] = base;
+            idx[1] = base + 1;
+            idx[2] = base + 2;
+            idx[3] = base;
+            idx[4] = base + 2;
+            idx[5] = base + 3;
+        }
+    }
+
+    SpriteVertex* vertices = arena.alloc_array<SpriteVertex>(static_cast<std::size_t>(visible) * 4);
+    const std::uint32_t* rgba = ps.rgba();
+    const SpriteFrame frame = draw.frame;
+    parallel_for(jobs, ranges, 1, [&](std::uint32_t first, std::uint32_t last) {
+        for (std::uint32_t r = first; r < last; ++r) {
+            SpriteVertex* v = vertices + static_cast<std::size_t>(offsets[r]) * 4;
+            for (std::uint32_t i = range_begin(r); i < range_begin(r + 1); ++i) {
+                float x0, y0;
+                if (!corner(i, x0, y0)) continue;
+                const float x1 = x0 + size, y1 = y0 + size;
+                const std::uint8_t cr = static_cast<std::uint8_t>(rgba[i] >> 24);
+                const std::uint8_t cg = static_cast<std::uint8_t>(rgba[i] >> 16);
+                const std::uint8_t cb = static_cast<std::uint8_t>(rgba[i] >> 8);
+                const std::uint8_t ca = static_cast<std::uint8_t>(rgba[i]);
+                v[0] = {x0, y0, cr, cg, cb, ca, frame.u0, frame.v0};
+                v[1] = {x1, y0, cr, cg, cb, ca, frame.u1, frame.v0};
+                v[2] = {x1, y1, cr, cg, cb, ca, frame.u1, frame.v1};
+                v[3] = {x0, y1, cr, cg, cb, ca, frame.u0, frame.v1};
+                v += 4;
+            }
+        }
+    });
+
+    out = {};
+    out.atlas = frame.atlas;
+    out.layer = draw.layer;
+    out.vertices = vertices;
+    out.vertex_count = static_cast<int>(visible * 4);
+    out.indices = particle_indices_.data();
+    out.index_count = static_cast<int>(visible * 6);
+    out.sprite_count = static_cast<int>(visible);
+    stats_.particles = visible;
+    return true;
+}
+
+} // namespace game
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/frame_arena.hpp"
+#include "render/render_list.hpp"
+
+namespace game {
+
+class JobSystem;
+
+// Layout-compatible with SDL_Vertex (SDL_FPoint, SDL_Color, SDL_FPoint) so the
+// SDL backend can hand batches straight to SDL_RenderGeometry.
+struct SpriteVertex {
+    float x, y;
+    std::uint8_t r, g, b, a;
+    float u, v;
+};
+static_assert(sizeof(SpriteVertex) == 20, "SpriteVertex must match SDL_Vertex");
+
+// One draw call: every sprite of one layer that samples one atlas page.
+// Indices are relative to `vertices`.
+struct SpriteBatch {
+    std::uint16_t atlas = 0;
+    std::uint8_t layer = 0;
+    const SpriteVertex* vertices = nullptr;
+    int vertex_count = 0;
+    const int* indices = nullptr;
+    int index_count = 0;
+    int sprite_count = 0;
+};
+
+// The batches of one build(), stored in the frame arena.
+struct SpriteBatchList {
+    const SpriteBatch* items = nullptr;
+    std::size_t count = 0;
+
+    const SpriteBatch* begin() const { return items; }
+    const SpriteBatch* end() const { return items + count; }
+    std::size_t size() const { return count; }
+};
+
+struct SpriteBatchStats {
+    std::uint32_t sprites = 0;
+    std::uint32_t batches = 0;
+    std::uint32_t dropped = 0;    // past SpriteBatcher::kMaxSprites
+    std::uint32_t particles = 0;  // visible particles, in their own batch
+};
+
+// Turns a frame's sprites into as few geometry submissions as possible.
+//
+// Sprites are ordered by (layer, atlas, bottom edge) with a radix sort of
+// packed 64-bit keys, keeping submission order among equal keys, and each
+// run of equal (layer, atlas) becomes one batch. Sort keys, batches,
+// vertices and indices are all carved from the frame arena, so they are
+// valid until it is reset. With a job system the vertex and index writing is
+// split across threads; the output is the same.
+//
+// A frame's particles skip the sprite path: they are culled straight from the
+// particle columns and written as one more batch, in particle order, after
+// the sprite batches of their layer. Unlike actors they are not culled
+// through the broad-phase grid: every particle moves every tick and removal
+// reorders them, so keeping them in cells would itself be a pass over all of
+// them, and a branch-free test per particle is about as cheap. Every particle quad has the same index
+// pattern, so those indices are kept from frame to frame.
+class SpriteBatcher {
+public:
+    // Sort keys have 16 bits for the sprite index; later sprites are dropped.
+    static constexpr std::size_t kMaxSprites = 1u << 16;
+
+    void build(const Sprite* sprites, std::size_t count, FrameArena& arena, JobSystem* jobs = nullptr);
+    void build(const Pool<Sprite>& sprites, FrameArena& arena, JobSystem* jobs = nullptr) {
+        build(sprites.data(), sprites.size(), arena, jobs);
+    }
+    // The list's sprites and its particles.
+    void build(const RenderList& list, FrameArena& arena, JobSystem* jobs = nullptr);
+
+    const SpriteBatchList& batches() const { return batches_; }
+    const SpriteBatchStats& stats() const { return stats_; }
+
+private:
+    // Writes the visible particles of `draw` as one batch; false if none are.
+    bool build_particles(const ParticleDraw& draw, FrameArena& arena, JobSystem* jobs, SpriteBatch& out);
+
+    SpriteBatchList batches_;
+    SpriteBatchStats stats_;
+    std::vector<int> particle_indices_;  // grows with the particle capacity
+};
+
+} // namespace game
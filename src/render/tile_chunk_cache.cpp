@@ -0,0 +1,25 @@
+#include "render/tile_chunk_cache.hpp"
+
+namespace game {
+
+TileChunkCache::Lookup TileChunkCache::acquire(const TileChunk* chunk, std::uint64_t frame) {
+    int victim = 0;
+    for (int i = 0; i < kSlots; ++i) {
+        Slot& s = slots_[i];
+        if (s.chunk == chunk) {
+            const bool stale = s.revision != chunk->revision;
+            s.revision = chunk->revision;
+            s.last_used = frame;
+            return {i, stale};
+        }
+        if (!s.chunk || (slots_[victim].chunk && s.last_used < slots_[victim].last_used)) victim = i;
+    }
+    slots_[victim] = {chunk, chunk->revision, frame};
+    return {victim, true};
+}
+
+void TileChunkCache::clear() {
+    for (Slot& s : slots_) s = {};
+}
+
+} // namespace game
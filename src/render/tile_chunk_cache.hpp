@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// Bookkeeping for backends that keep tile chunks pre-rendered in a fixed set
+// of texture slots. It only decides which slot a chunk lives in and whether
+// that slot must be redrawn, so the policy can be measured headlessly.
+//
+// A slot is redrawn when it is first given to a chunk and whenever the
+// chunk's revision has moved on since it was drawn. When every slot is taken
+// the least recently drawn chunk loses its slot, so kSlots must exceed the
+// chunks one frame shows (a 640x360 view touches at most 3x2 of them).
+// Chunks are identified by address, so clear() the cache when the level is
+// replaced.
+class TileChunkCache {
+public:
+    static constexpr int kSlots = 16;
+
+    struct Lookup {
+        int slot;
+        bool redraw;
+    };
+
+    // Slot for `chunk` in frame `frame` (any counter that increases once
+    // per frame).
+    Lookup acquire(const TileChunk* chunk, std::uint64_t frame);
+
+    // Forgets every slot's contents, e.g. after a level change or when the
+    // renderer lost its render targets.
+    void clear();
+
+private:
+    struct Slot {
+        const TileChunk* chunk = nullptr;
+        std::uint32_t revision = 0;
+        std::uint64_t last_used = 0;
+    };
+
+    Slot slots_[kSlots];
+};
+
+} // namespace game
@@ -0,0 +1,111 @@
+#include "sim/actor_store.hpp"
+
+namespace game {
+
+namespace {
+
+template <typename T>
+void swap_remove(std::vector<T>& v, std::size_t i) {
+    v[i] = v.back();
+    v.pop_back();
+}
+
+} // namespace
+
+ActorHandle ActorStore::spawn(ActorKind k, Vec2 pos, Vec2 size, Vec2 vel, std::uint8_t initial_flags) {
+    std::uint32_t index;
+    if (!free_indices_.empty()) {
+        index = free_indices_.back();
+        free_indices_.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(generation_.size());
+        generation_.push_back(0);
+        sparse_to_dense_.push_back(kInvalid);
+    }
+
+    const std::uint32_t dense = static_cast<std::uint32_t>(x.size());
+    sparse_to_dense_[index] = dense;
+    dense_to_sparse_.push_back(index);
+
+    x.push_back(Real(pos.x));
+    y.push_back(Real(pos.y));
+    prev_x.push_back(Real(pos.x));
+    prev_y.push_back(Real(pos.y));
+    vel_x.push_back(Real(vel.x));
+    vel_y.push_back(Real(vel.y));
+    w.push_back(Real(size.x));
+    h.push_back(Real(size.y));
+    timer.push_back(0.0f);
+    kind.push_back(k);
+    flags.push_back(initial_flags);
+
+    return {index, generation_[index]};
+}
+
+bool ActorStore::destroy(ActorHandle handle) {
+    if (!alive(handle)) return false;
+
+    const std::uint32_t dense = sparse_to_dense_[handle.index];
+    const std::uint32_t last = static_cast<std::uint32_t>(x.size() - 1);
+    const std::uint32_t moved_index = dense_to_sparse_[last];
+
+    swap_remove(x, dense);
+    swap_remove(y, dense);
+    swap_remove(prev_x, dense);
+    swap_remove(prev_y, dense);
+    swap_remove(vel_x, dense);
+    swap_remove(vel_y, dense);
+    swap_remove(w, dense);
+    swap_remove(h, dense);
+    swap_remove(timer, dense);
+    swap_remove(kind, dense);
+    swap_remove(flags, dense);
+    swap_remove(dense_to_sparse_, dense);
+
+    sparse_to_dense_[moved_index] = dense;
+    sparse_to_dense_[handle.index] = kInvalid;
+    ++generation_[handle.index];
+    free_indices_.push_back(handle.index);
+    return true;
+}
+
+void ActorStore::reserve(std::size_t n) {
+    x.reserve(n);
+    y.reserve(n);
+    prev_x.reserve(n);
+    prev_y.reserve(n);
+    vel_x.reserve(n);
+    vel_y.reserve(n);
+    w.reserve(n);
+    h.reserve(n);
+    timer.reserve(n);
+    kind.reserve(n);
+    flags.reserve(n);
+    dense_to_sparse_.reserve(n);
+    sparse_to_dense_.reserve(n);
+    generation_.reserve(n);
+    free_indices_.reserve(n);
+}
+
+void ActorStore::clear() {
+    // Bump every live generation so outstanding handles go stale.
+    for (std::uint32_t index : dense_to_sparse_) {
+        ++generation_[index];
+        sparse_to_dense_[index] = kInvalid;
+        free_indices_.push_back(index);
+    }
+    x.clear();
+    y.clear();
+    prev_x.clear();
+    prev_y.clear();
+    vel_x.clear();
+    vel_y.clear();
+    w.clear();
+    h.clear();
+    timer.clear();
+    kind.clear();
+    flags.clear();
+    dense_to_sparse_.clear();
+}
+
+} // namespace game
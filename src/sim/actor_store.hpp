@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/fixed.hpp"
+#include "core/math.hpp"
+
+namespace game {
+
+enum class ActorKind : std::uint8_t {
+    Player,
+    Enemy,
+    Projectile,
+    Pickup,
+};
+
+enum ActorFlag : std::uint8_t {
+    kActorOnGround = 1u << 0,
+    kActorGravity = 1u << 1,
+    kActorFacingLeft = 1u << 2,
+    kActorExpired = 1u << 3,  // destruction queued for the end of the tick
+};
+
+// Stable reference to an actor. The generation is bumped every time a slot is
+// reused, so a handle to a destroyed actor never aliases its replacement.
+struct ActorHandle {
+    std::uint32_t index = UINT32_MAX;
+    std::uint32_t generation = 0;
+
+    bool operator==(const ActorHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const ActorHandle& o) const { return !(*this == o); }
+};
+
+// Structure-of-arrays storage for every actor in a level.
+//
+// Per-actor data lives in parallel dense arrays that physics and collision
+// walk front to back; destroy() swap-removes so the arrays stay packed. The
+// sparse tables only exist to translate handles into dense slots.
+class ActorStore {
+public:
+    // Dense columns, all the same length (size()). Positions are the top-left
+    // corner in world pixels; prev_* hold the previous tick for interpolation.
+    // Real is float, or Fixed in fixed-point builds.
+    std::vector<Real> x, y;
+    std::vector<Real> prev_x, prev_y;
+    std::vector<Real> vel_x, vel_y;
+    std::vector<Real> w, h;
+    std::vector<float> timer;  // per-kind countdown (e.g. enemy fire cooldown)
+    std::vector<ActorKind> kind;
+    std::vector<std::uint8_t> flags;
+
+    ActorHandle spawn(ActorKind k, Vec2 pos, Vec2 size, Vec2 vel = {}, std::uint8_t initial_flags = 0);
+
+    // Returns false if the handle was already stale.
+    bool destroy(ActorHandle handle);
+
+    bool alive(ActorHandle handle) const {
+        return handle.index < generation_.size() && generation_[handle.index] == handle.generation &&
+               sparse_to_dense_[handle.index] != kInvalid;
+    }
+
+    // Dense slot of a live actor. Slots change when other actors are
+    // destroyed, so only hold them for the duration of a pass.
+    std::uint32_t slot(ActorHandle handle) const { return sparse_to_dense_[handle.index]; }
+    ActorHandle handle_at(std::uint32_t slot) const {
+        const std::uint32_t index = dense_to_sparse_[slot];
+        return {index, generation_[index]};
+    }
+
+    std::size_t size() const { return x.size(); }
+    // Sizes every column and table for n actors, so spawning up to n never
+    // reallocates.
+    void reserve(std::size_t n);
+    void clear();
+
+    Aabb bounds(std::uint32_t slot) const {
+        return {to_float(x[slot]), to_float(y[slot]), to_float(w[slot]), to_float(h[slot])};
+    }
+
+    // Calls f(column) for every array that makes up the store's state,
+    // private handle tables included, so snapshots can copy them wholesale.
+    // prev_x/prev_y are left out: they only feed interpolation and every
+    // tick overwrites them before reading.
+    template <typename F>
+    void for_each_column(F&& f) {
+        visit_columns(*this, f);
+    }
+    template <typename F>
+    void for_each_column(F&& f) const {
+        visit_columns(*this, f);
+    }
+
+private:
+    static constexpr std::uint32_t kInvalid = UINT32_MAX;
+
+    template <typename Store, typename F>
+    static void visit_columns(Store& s, F& f) {
+        f(s.x);
+        f(s.y);
+        f(s.vel_x);
+        f(s.vel_y);
+        f(s.w);
+        f(s.h);
+        f(s.timer);
+        f(s.kind);
+        f(s.flags);
+        f(s.sparse_to_dense_);
+        f(s.dense_to_sparse_);
+        f(s.generation_);
+        f(s.free_indices_);
+    }
+
+    std::vector<std::uint32_t> sparse_to_dense_;
+    std::vector<std::uint32_t> dense_to_sparse_;
+    std::vector<std::uint32_t> generation_;
+    std::vector<std::uint32_t> free_indices_;
+};
+
+} // namespace game
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game {
+
+enum Button : std::uint8_t {
+    kButtonLeft = 1u << 0,
+    kButtonRight = 1u << 1,
+    kButtonJump = 1u << 2,
+};
+
+// Buttons held during one simulation tick. Kept to a single byte so input
+// streams are cheap to store and compare.
+struct InputState {
+    std::uint8_t buttons = 0;
+
+    bool held(Button b) const { return (buttons & b) != 0; }
+    void set(Button b, bool down) {
+        buttons = static_cast<std::uint8_t>(down ? (buttons | b) : (buttons & ~b));
+    }
+};
+
+} // namespace game
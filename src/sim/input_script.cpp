@@ -0,0 +1,23 @@
+#include "sim/input_script.hpp"
+
+#include "core/rng.hpp"
+
+namespace game {
+
+InputState InputScript::at(std::uint64_t tick) const {
+    // Direction flips every ~8 seconds at 120 Hz; jumps are held for a
+    // quarter of a second and start roughly twice a second.
+    constexpr std::uint64_t kLeg = 960;
+    constexpr std::uint64_t kJumpWindow = 30;
+
+    InputState in;
+    const bool rightward = ((tick / kLeg) & 1u) == 0;
+    in.set(rightward ? kButtonRight : kButtonLeft, true);
+
+    const std::uint64_t window = tick / kJumpWindow;
+    const std::uint32_t h = hash32(static_cast<std::uint32_t>(window) ^ hash32(seed_));
+    in.set(kButtonJump, (h & 3u) != 0 && (tick % kJumpWindow) < kJumpWindow / 2);
+    return in;
+}
+
+} // namespace game
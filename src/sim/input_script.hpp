@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include "sim/input.hpp"
+
+namespace game {
+
+// Deterministic stand-in for a player: runs back and forth across the level,
+// jumping at pseudo-random intervals. The same seed always yields the same
+// input on the same tick, so headless runs are repeatable.
+class InputScript {
+public:
+    explicit InputScript(std::uint32_t seed = 1) : seed_(seed) {}
+
+    InputState at(std::uint64_t tick) const;
+
+private:
+    std::uint32_t seed_;
+};
+
+} // namespace game
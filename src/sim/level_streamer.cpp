@@ -0,0 +1,197 @@
+#include "sim/level_streamer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+
+namespace game {
+
+namespace {
+
+constexpr std::size_t kRequestCapacity = 256;
+constexpr std::size_t kResultCapacity = 16;
+constexpr float kChunkPixels = static_cast<float>(TileMap::kTileSize * TileChunk::kSize);
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+// Chunks a span of `pixels` can touch at worst, for any alignment.
+int chunks_spanned(float pixels, int limit) {
+    return std::min(static_cast<int>(std::ceil(pixels / kChunkPixels)) + 1, limit);
+}
+
+} // namespace
+
+LevelStreamer::~LevelStreamer() {
+    if (!io_thread_.joinable()) return;
+    stop_.store(true);
+    wake_io();
+    io_thread_.join();
+}
+
+bool LevelStreamer::open(const std::string& path, const StreamConfig& config, float view_w, float view_h,
+                         std::string* error) {
+    if (io_thread_.joinable()) return fail(error, "level streamer is already open");
+    if (!file_.open(path, error)) return false;
+    config_ = config;
+    slots_ = static_cast<int>(config.budget_bytes / sizeof(TileChunk));
+    const int needed = chunks_spanned(view_w + 2.0f * config.margin, file_.chunks_x()) *
+                       chunks_spanned(view_h + 2.0f * config.margin, file_.chunks_y());
+    if (slots_ < needed) {
+        return fail(error, "stream budget of " + std::to_string(config.budget_bytes / 1024) + " KB holds " +
+                               std::to_string(slots_) + " chunks; the view needs " + std::to_string(needed));
+    }
+
+    state_.assign(static_cast<std::size_t>(file_.chunks_x()) * file_.chunks_y(), kNotLoaded);
+    resident_.reserve(static_cast<std::size_t>(slots_));
+    requests_ = std::make_unique<SpscQueue<std::uint32_t>>(kRequestCapacity);
+    results_ = std::make_unique<SpscQueue<ChunkLoad>>(kResultCapacity);
+    io_scratch_ = std::make_unique<ChunkLoad>();
+    io_thread_ = std::thread([this] { io_main(); });
+    return true;
+}
+
+TileMap LevelStreamer::make_map() const {
+    return TileMap::streamed(file_.width(), file_.height(), slots_);
+}
+
+void LevelStreamer::prime(TileMap& map, const Aabb& view) {
+    while (step(map, view, INT_MAX) > 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+void LevelStreamer::update(TileMap& map, const Aabb& view) {
+    step(map, view, config_.max_installs);
+}
+
+LevelStreamer::Region LevelStreamer::region(const Aabb& box) const {
+    auto cell = [](float v, int count) {
+        return std::clamp(static_cast<int>(std::floor(v / kChunkPixels)), 0, count - 1);
+    };
+    return {cell(box.x, file_.chunks_x()), cell(box.y, file_.chunks_y()), cell(box.x + box.w, file_.chunks_x()),
+            cell(box.y + box.h, file_.chunks_y())};
+}
+
+bool LevelStreamer::evict(TileMap& map, const Region& wanted, Vec2 centre) {
+    const int cx_n = file_.chunks_x();
+    std::size_t victim = resident_.size();
+    float farthest = -1.0f;
+    for (std::size_t i = 0; i < resident_.size(); ++i) {
+        const int cx = static_cast<int>(resident_[i] % static_cast<std::uint32_t>(cx_n));
+        const int cy = static_cast<int>(resident_[i] / static_cast<std::uint32_t>(cx_n));
+        if (wanted.contains(cx, cy)) continue;
+        const float dx = (static_cast<float>(cx) + 0.5f) * kChunkPixels - centre.x;
+        const float dy = (static_cast<float>(cy) + 0.5f) * kChunkPixels - centre.y;
+        if (dx * dx + dy * dy > farthest) {
+            farthest = dx * dx + dy * dy;
+            victim = i;
+        }
+    }
+    if (victim == resident_.size()) return false;
+
+    const std::uint32_t index = resident_[victim];
+    map.page_out(static_cast<int>(index % static_cast<std::uint32_t>(cx_n)),
+                 static_cast<int>(index / static_cast<std::uint32_t>(cx_n)));
+    state_[index] = kNotLoaded;
+    resident_[victim] = resident_.back();
+    resident_.pop_back();
+    ++stats_.evictions;
+    return true;
+}
+
+int LevelStreamer::step(TileMap& map, const Aabb& view, int max_installs) {
+    const int cx_n = file_.chunks_x();
+    const Region visible = region(view);
+    const Region wanted = region({view.x - config_.margin, view.y - config_.margin, view.w + 2.0f * config_.margin,
+                                  view.h + 2.0f * config_.margin});
+    const Vec2 centre{view.x + view.w * 0.5f, view.y + view.h * 0.5f};
+
+    // Install finished loads straight out of the queue.
+    bool installed = false;
+    for (int i = 0; i < max_installs; ++i) {
+        const ChunkLoad* load = results_->front();
+        if (!load) break;
+        const std::uint32_t index = load->index;
+        const int cx = static_cast<int>(index % static_cast<std::uint32_t>(cx_n));
+        const int cy = static_cast<int>(index / static_cast<std::uint32_t>(cx_n));
+        --in_flight_;
+        if (!load->ok) {
+            state_[index] = kFailed;
+            ++stats_.read_errors;
+        } else if (wanted.contains(cx, cy) &&
+                   (static_cast<int>(resident_.size()) < slots_ || evict(map, wanted, centre)) &&
+                   map.page_in(cx, cy, load->tiles)) {
+            state_[index] = kResident;
+            resident_.push_back(index);
+            ++stats_.loads;
+        } else {
+            state_[index] = kNotLoaded;
+            ++stats_.dropped;
+        }
+        results_->pop();
+        installed = true;
+    }
+
+    // Ask for missing chunks, the visible ones first. A request needs a slot
+    // to land in, so make room before sending it.
+    bool requested = false;
+    int pending = 0;
+    auto request = [&](int cx, int cy) {
+        const std::uint32_t index = static_cast<std::uint32_t>(cy) * static_cast<std::uint32_t>(cx_n) +
+                                    static_cast<std::uint32_t>(cx);
+        if (state_[index] == kRequested) ++pending;
+        if (state_[index] != kNotLoaded) return;
+        ++pending;
+        if (static_cast<int>(resident_.size()) + in_flight_ >= slots_ && !evict(map, wanted, centre)) return;
+        if (!requests_->push(index)) return;
+        state_[index] = kRequested;
+        ++in_flight_;
+        requested = true;
+    };
+    for (int cy = visible.cy0; cy <= visible.cy1; ++cy) {
+        for (int cx = visible.cx0; cx <= visible.cx1; ++cx) request(cx, cy);
+    }
+    stats_.missing_in_view = pending;
+    for (int cy = wanted.cy0; cy <= wanted.cy1; ++cy) {
+        for (int cx = wanted.cx0; cx <= wanted.cx1; ++cx) {
+            if (!visible.contains(cx, cy)) request(cx, cy);
+        }
+    }
+    // Installing only needs a wake-up if the I/O thread is waiting for room;
+    // the fence orders the pops above before reading its flag.
+    if (installed) std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (requested || (installed && io_full_.load())) wake_io();
+    return pending;
+}
+
+void LevelStreamer::wake_io() {
+    // Taking the mutex orders this after the I/O thread's last look at the
+    // queues: it either sees what changed or is already waiting.
+    { std::lock_guard<std::mutex> lock(wake_mutex_); }
+    wake_.notify_one();
+}
+
+void LevelStreamer::io_main() {
+    const auto cx_n = static_cast<std::uint32_t>(file_.chunks_x());
+    ChunkLoad& load = *io_scratch_;
+    while (!stop_.load()) {
+        std::uint32_t index = 0;
+        if (!requests_->pop(index)) {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait(lock, [this] { return stop_.load() || requests_->front() != nullptr; });
+            continue;
+        }
+        load.index = index;
+        load.ok = file_.read_chunk(static_cast<int>(index % cx_n), static_cast<int>(index / cx_n), load.tiles, nullptr);
+        if (results_->push(load)) continue;
+        // The results queue is full until update() installs some.
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        io_full_.store(true);
+        wake_.wait(lock, [&] { return stop_.load() || results_->push(load); });
+        io_full_.store(false);
+    }
+}
+
+} // namespace game
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assets/level_file.hpp"
+#include "core/math.hpp"
+#include "core/spsc_queue.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+struct StreamConfig {
+    // Memory for resident chunks; sets TileMap::chunk_slots().
+    std::size_t budget_bytes = 256 * 1024;
+    // Distance around the view, in pixels, to have paged in before the
+    // camera gets there.
+    float margin = 512.0f;
+    // Chunks installed per update(), so a burst of finished loads is spread
+    // over several frames.
+    int max_installs = 8;
+};
+
+// Pages the chunks of a level file in and out of a streamed TileMap around
+// the camera, so a level of any size runs in the same memory.
+//
+// A background thread does all file I/O and decoding. update(), called once
+// per frame from the game thread between ticks, asks it for missing chunks
+// near the view over one lock-free SPSC queue and installs what it has
+// finished from another, so the game thread never waits on the disk. When
+// the budget is full, the resident chunk farthest from the view that is
+// outside the wanted region is paged out first. Chunks that are not resident
+// read as solid and draw nothing.
+class LevelStreamer {
+public:
+    struct Stats {
+        std::uint64_t loads = 0;      // chunks installed
+        std::uint64_t evictions = 0;  // chunks paged out for space
+        std::uint64_t dropped = 0;    // loads no longer wanted when they arrived
+        std::uint64_t read_errors = 0;  // chunks that failed to load; they stay solid
+        // Chunks touching the view that were still missing after the last
+        // update(); anything but 0 means the margin is too small for the
+        // camera speed or the disk.
+        int missing_in_view = 0;
+    };
+
+    LevelStreamer() = default;
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // Opens the level and starts the I/O thread. Fails if the budget cannot
+    // hold the chunks around a view_w x view_h view.
+    bool open(const std::string& path, const StreamConfig& config, float view_w, float view_h, std::string* error);
+
+    // An empty streamed map with the level's size and the budget's slots.
+    TileMap make_map() const;
+
+    // Blocks until everything around `view` is resident, e.g. before the
+    // first frame.
+    void prime(TileMap& map, const Aabb& view);
+    void update(TileMap& map, const Aabb& view);
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    enum ChunkState : std::uint8_t { kNotLoaded, kRequested, kResident, kFailed };
+
+    struct ChunkLoad {
+        std::uint32_t index;
+        bool ok;
+        Tile tiles[TileChunk::kSize * TileChunk::kSize];
+    };
+
+    struct Region {
+        int cx0, cy0, cx1, cy1;  // inclusive
+        bool contains(int cx, int cy) const { return cx >= cx0 && cx <= cx1 && cy >= cy0 && cy <= cy1; }
+    };
+
+    // One update with an install limit. Returns the wanted chunks that are
+    // still on their way.
+    int step(TileMap& map, const Aabb& view, int max_installs);
+    Region region(const Aabb& box) const;
+    // Pages out the farthest resident chunk outside `wanted`, if any.
+    bool evict(TileMap& map, const Region& wanted, Vec2 centre);
+    void wake_io();
+    void io_main();
+
+    LevelFile file_;
+    StreamConfig config_;
+    int slots_ = 0;
+    std::vector<std::uint8_t> state_;     // ChunkState per chunk of the level
+    std::vector<std::uint32_t> resident_;  // chunk indices, at most slots_
+    int in_flight_ = 0;
+    Stats stats_;
+
+    std::unique_ptr<SpscQueue<std::uint32_t>> requests_;
+    std::unique_ptr<SpscQueue<ChunkLoad>> results_;
+    std::unique_ptr<ChunkLoad> io_scratch_;
+    std::thread io_thread_;
+    // The I/O thread sleeps here while it has no requests or no room for
+    // results. update() wakes it after sending requests, or after installing
+    // results while io_full_ is set; the destructor wakes it to stop.
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> io_full_{false};  // set while the I/O thread waits for room
+};
+
+} // namespace game
@@ -0,0 +1,84 @@
+#include "sim/levels.hpp"
+
+#include "core/rng.hpp"
+#include "sim/world.hpp"
+
+namespace game {
+
+TileMap make_demo_level() {
+    return TileMap::from_ascii({
+        "########################################",
+        "#                                      #",
+        "#                                      #",
+        "#                                      #",
+        "#                         ######       #",
+        "#                                      #",
+        "#                                      #",
+        "#               #####                  #",
+        "#                                ####  #",
+        "#                                      #",
+        "#        ####                          #",
+        "#                        ###           #",
+        "#                                      #",
+        "#   ###            ###                 #",
+        "#                                 #    #",
+        "#                                ##    #",
+        "#                               ###    #",
+        "#                   #          ####    #",
+        "#                  ##         #####    #",
+        "########################################",
+    });
+}
+
+TileMap make_generated_level(int width, int height, std::uint32_t seed) {
+    TileMap map(width, height);
+    Rng rng(seed);
+
+    for (int x = 0; x < width; ++x) {
+        map.set(x, 0, Tile::Solid);
+        map.set(x, height - 1, Tile::Solid);
+    }
+    for (int y = 0; y < height; ++y) {
+        map.set(0, y, Tile::Solid);
+        map.set(width - 1, y, Tile::Solid);
+    }
+
+    // Floor with gentle steps the player can walk or hop over.
+    int floor_h = 2;
+    for (int x = 1; x < width - 1; ++x) {
+        if (x % 6 == 0) floor_h = rng.range(1, 3);
+        for (int y = height - 1 - floor_h; y < height - 1; ++y) map.set(x, y, Tile::Solid);
+    }
+
+    // Floating platforms, roughly one per 48 tiles of area.
+    const int platforms = (width * height) / 48;
+    for (int i = 0; i < platforms; ++i) {
+        const int len = rng.range(3, 8);
+        const int px = rng.range(2, width - len - 2);
+        const int py = rng.range(3, height - 7);
+        for (int x = px; x < px + len; ++x) map.set(x, py, Tile::Solid);
+    }
+    return map;
+}
+
+void populate_actors(World& world, int count, std::uint32_t seed) {
+    const TileMap& map = world.map();
+    const float ts = static_cast<float>(TileMap::kTileSize);
+    Rng rng(seed ^ 0x9e3779b9u);
+    world.reserve(world.actors().size() + static_cast<std::size_t>(count));
+    for (int placed = 0, attempts = 0; placed < count && attempts < count * 16; ++attempts) {
+        const int tx = rng.range(1, map.width() - 2);
+        const int ty = rng.range(1, map.height() - 2);
+        if (map.solid(tx, ty)) continue;
+        const Vec2 pos{tx * ts + 1.0f, ty * ts + 1.0f};
+        if (rng.range(0, 9) < 7) {
+            world.spawn_enemy(pos);
+        } else {
+            world.spawn_pickup(pos);
+        }
+        ++placed;
+    }
+    world.refresh_grid();
+}
+
+} // namespace game
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+class World;
+
+// Small hand-made level used by the windowed game.
+TileMap make_demo_level();
+
+// Procedural level for headless runs: a walled box with a bumpy floor and
+// scattered floating platforms. Deterministic for a given seed.
+TileMap make_generated_level(int width, int height, std::uint32_t seed);
+
+// Scatters `count` enemies and pickups over empty tiles of the world's map.
+void populate_actors(World& world, int count, std::uint32_t seed);
+
+} // namespace game
@@ -0,0 +1,179 @@
+#include "sim/particle_system.hpp"
+
+#include <algorithm>
+
+#include "core/job_system.hpp"
+#include "core/profiler.hpp"
+#include "core/rng.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GAME_PARTICLE_X86 1
+#else
+#define GAME_PARTICLE_X86 0
+#endif
+
+namespace game {
+
+namespace {
+
+// Minimum particles per integration job.
+constexpr std::uint32_t kParticleGrain = 4096;
+
+// The columns integration touches.
+struct Motion {
+    float* x;
+    float* y;
+    float* prev_x;
+    float* prev_y;
+    float* vel_x;
+    float* vel_y;
+    float* life;
+};
+
+// Every particle in the range moves, expired or not: the expired ones are
+// removed before anything reads them again, and skipping them would cost the
+// vector paths a mask per field.
+void integrate_scalar(const Motion& m, std::size_t begin, std::size_t end, float dt, float dv) {
+    for (std::size_t i = begin; i < end; ++i) {
+        m.life[i] -= dt;
+        m.prev_x[i] = m.x[i];
+        m.prev_y[i] = m.y[i];
+        m.vel_y[i] += dv;
+        m.x[i] += m.vel_x[i] * dt;
+        m.y[i] += m.vel_y[i] * dt;
+    }
+}
+
+#if GAME_PARTICLE_X86
+
+std::size_t integrate_sse2(const Motion& m, std::size_t begin, std::size_t end, float dt, float dv) {
+    const std::size_t stop = begin + ((end - begin) & ~std::size_t{3});
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vdv = _mm_set1_ps(dv);
+    for (std::size_t i = begin; i < stop; i += 4) {
+        const __m128 x = _mm_loadu_ps(&m.x[i]);
+        const __m128 y = _mm_loadu_ps(&m.y[i]);
+        const __m128 vy = _mm_add_ps(_mm_loadu_ps(&m.vel_y[i]), vdv);
+        _mm_storeu_ps(&m.life[i], _mm_sub_ps(_mm_loadu_ps(&m.life[i]), vdt));
+        _mm_storeu_ps(&m.prev_x[i], x);
+        _mm_storeu_ps(&m.prev_y[i], y);
+        _mm_storeu_ps(&m.vel_y[i], vy);
+        _mm_storeu_ps(&m.x[i], _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(&m.vel_x[i]), vdt)));
+        _mm_storeu_ps(&m.y[i], _mm_add_ps(y, _mm_mul_ps(vy, vdt)));
+    }
+    return stop;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GAME_TARGET_AVX2 __attribute__((target("avx2")))
+
+GAME_TARGET_AVX2 std::size_t integrate_avx2(const Motion& m, std::size_t begin, std::size_t end, float dt,
+                                            float dv) {
+    const std::size_t stop = begin + ((end - begin) & ~std::size_t{7});
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 vdv = _mm256_set1_ps(dv);
+    for (std::size_t i = begin; i < stop; i += 8) {
+        const __m256 x = _mm256_loadu_ps(&m.x[i]);
+        const __m256 y = _mm256_loadu_ps(&m.y[i]);
+        const __m256 vy = _mm256_add_ps(_mm256_loadu_ps(&m.vel_y[i]), vdv);
+        _mm256_storeu_ps(&m.life[i], _mm256_sub_ps(_mm256_loadu_ps(&m.life[i]), vdt));
+        _mm256_storeu_ps(&m.prev_x[i], x);
+        _mm256_storeu_ps(&m.prev_y[i], y);
+        _mm256_storeu_ps(&m.vel_y[i], vy);
+        _mm256_storeu_ps(&m.x[i], _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(&m.vel_x[i]), vdt)));
+        _mm256_storeu_ps(&m.y[i], _mm256_add_ps(y, _mm256_mul_ps(vy, vdt)));
+    }
+    return stop;
+}
+#define GAME_PARTICLE_AVX2 1
+#else
+#define GAME_PARTICLE_AVX2 0
+#endif
+
+#endif // GAME_PARTICLE_X86
+
+// All levels run the same IEEE operations per particle (no fused
+// multiply-add), so they produce bit-identical columns.
+void integrate(const Motion& m, std::size_t begin, std::size_t end, float dt, float dv, SimdLevel level) {
+    std::size_t done = begin;
+#if GAME_PARTICLE_X86
+#if GAME_PARTICLE_AVX2
+    if (level == SimdLevel::Avx2) {
+        done = integrate_avx2(m, begin, end, dt, dv);
+    } else
+#endif
+    if (level != SimdLevel::Scalar) {
+        done = integrate_sse2(m, begin, end, dt, dv);
+    }
+#else
+    (void)level;
+#endif
+    integrate_scalar(m, done, end, dt, dv);
+}
+
+} // namespace
+
+void ParticleSystem::reserve(std::size_t capacity) {
+    if (capacity <= life_.size()) return;
+    x_.resize(capacity);
+    y_.resize(capacity);
+    prev_x_.resize(capacity);
+    prev_y_.resize(capacity);
+    vel_x_.resize(capacity);
+    vel_y_.resize(capacity);
+    life_.resize(capacity);
+    rgba_.resize(capacity);
+}
+
+void ParticleSystem::emit(const ParticleBurst* bursts, std::size_t count) {
+    for (std::size_t b = 0; b < count; ++b) {
+        const ParticleBurst& burst = bursts[b];
+        const std::size_t wanted = burst.count > 0 ? static_cast<std::size_t>(burst.count) : 0;
+        const std::size_t n = std::min(wanted, capacity() - size_);
+        dropped_ += wanted - n;
+        if (n == 0) continue;
+        const std::size_t at = size_;
+        std::fill_n(x_.data() + at, n, burst.pos.x);
+        std::fill_n(y_.data() + at, n, burst.pos.y);
+        std::fill_n(prev_x_.data() + at, n, burst.pos.x);
+        std::fill_n(prev_y_.data() + at, n, burst.pos.y);
+        std::fill_n(life_.data() + at, n, burst.life);
+        std::fill_n(rgba_.data() + at, n, burst.rgba);
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::uint32_t h = hash32(burst.seed + static_cast<std::uint32_t>(k));
+            const float ux = static_cast<float>(h & 0xffffu) * (2.0f / 65535.0f) - 1.0f;
+            const float uy = static_cast<float>(h >> 16) * (1.0f / 65535.0f);
+            vel_x_[at + k] = ux * burst.speed;
+            vel_y_[at + k] = -uy * burst.speed;
+        }
+        size_ += n;
+    }
+}
+
+void ParticleSystem::update(float dt, float gravity, JobSystem* jobs, SimdLevel level) {
+    GAME_PROFILE_SCOPE("particles");
+    const Motion m{x_.data(), y_.data(), prev_x_.data(), prev_y_.data(), vel_x_.data(), vel_y_.data(), life_.data()};
+    const float dv = gravity * dt;
+    parallel_for(jobs, static_cast<std::uint32_t>(size_), kParticleGrain,
+                 [&](std::uint32_t begin, std::uint32_t end) { integrate(m, begin, end, dt, dv, level); });
+
+    for (std::size_t i = 0; i < size_;) {
+        if (life_[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        const std::size_t last = --size_;
+        if (i == last) break;
+        x_[i] = x_[last];
+        y_[i] = y_[last];
+        prev_x_[i] = prev_x_[last];
+        prev_y_[i] = prev_y_[last];
+        vel_x_[i] = vel_x_[last];
+        vel_y_[i] = vel_y_[last];
+        life_[i] = life_[last];
+        rgba_[i] = rgba_[last];
+    }
+}
+
+} // namespace game
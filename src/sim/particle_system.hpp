@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/cpu_features.hpp"
+#include "core/math.hpp"
+
+namespace game {
+
+class JobSystem;
+
+// `count` particles thrown upward from pos, each with a horizontal speed in
+// [-speed, speed] and an upward one in [0, speed] derived from seed.
+struct ParticleBurst {
+    Vec2 pos;
+    int count = 0;
+    float speed = 0.0f;
+    float life = 0.0f;  // seconds
+    std::uint32_t rgba = 0xffffffffu;
+    std::uint32_t seed = 0;
+};
+
+// Cosmetic particles (sparks, dust, debris) in structure-of-arrays form.
+//
+// Every field is its own dense column, so integration is one straight vector
+// loop per field and rendering reads only the columns it needs. Live
+// particles are packed at the front; expired ones are swap-removed. Like
+// Pool, all memory is claimed by the constructor or reserve(), and particles
+// emitted past the capacity are dropped and counted.
+class ParticleSystem {
+public:
+    explicit ParticleSystem(std::size_t capacity = 0) { reserve(capacity); }
+
+    // Grows the capacity, keeping live particles. The only call that touches
+    // the heap.
+    void reserve(std::size_t capacity);
+    void clear() { size_ = 0; }
+
+    // Emits every burst in order, filling each column for a burst at once.
+    void emit(const ParticleBurst* bursts, std::size_t count);
+    void emit(const ParticleBurst& burst) { emit(&burst, 1); }
+
+    // Ages every particle by dt and moves the survivors under `gravity`
+    // (pixels/s^2), then swap-removes the expired ones. Integration is split
+    // across `jobs` when given; removal runs on the calling thread, so the
+    // result is the same at any thread count and SIMD level.
+    void update(float dt, float gravity, JobSystem* jobs = nullptr, SimdLevel level = active_simd_level());
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return life_.size(); }
+    bool empty() const { return size_ == 0; }
+    // Particles emit() could not fit.
+    std::uint64_t dropped() const { return dropped_; }
+
+    // Columns, valid for [0, size()). Positions are centres in world pixels;
+    // prev_* hold the previous tick for interpolation.
+    const float* x() const { return x_.data(); }
+    const float* y() const { return y_.data(); }
+    const float* prev_x() const { return prev_x_.data(); }
+    const float* prev_y() const { return prev_y_.data(); }
+    const float* vel_x() const { return vel_x_.data(); }
+    const float* vel_y() const { return vel_y_.data(); }
+    const float* life() const { return life_.data(); }  // seconds left
+    const std::uint32_t* rgba() const { return rgba_.data(); }
+
+    // Calls f(column) with the start of every column, for snapshots. A
+    // restore writes size() elements into each, then calls resize().
+    template <typename F>
+    void for_each_column(F&& f) {
+        for_each_column_impl(*this, f);
+    }
+    template <typename F>
+    void for_each_column(F&& f) const {
+        for_each_column_impl(*this, f);
+    }
+    // Sets the live count (at most capacity()) without touching the columns.
+    void resize(std::size_t n) { size_ = n < capacity() ? n : capacity(); }
+
+private:
+    template <typename Self, typename F>
+    static void for_each_column_impl(Self& s, F& f) {
+        f(s.x_.data());
+        f(s.y_.data());
+        f(s.prev_x_.data());
+        f(s.prev_y_.data());
+        f(s.vel_x_.data());
+        f(s.vel_y_.data());
+        f(s.life_.data());
+        f(s.rgba_.data());
+    }
+
+    std::vector<float> x_, y_;
+    std::vector<float> prev_x_, prev_y_;
+    std::vector<float> vel_x_, vel_y_;
+    std::vector<float> life_;
+    std::vector<std::uint32_t> rgba_;
+    std::size_t size_ = 0;
+    std::uint64_t dropped_ = 0;
+};
+
+} // namespace game
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/fixed.hpp"
+#include "sim/actor_store.hpp"
+#include "sim/swept_aabb.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+// Actor physics templated on the number type, float or Fixed. World runs it
+// on Real, whichever one the build picked, and the fixed bench suite runs
+// both side by side, so the two builds share every line of it.
+
+// Tile coordinate containing world coordinate v, and the first tile at or
+// past it.
+template <typename T>
+int tile_floor(T v) {
+    return floor_int(v * T(1.0f / TileMap::kTileSize));
+}
+template <typename T>
+int tile_ceil(T v) {
+    return ceil_int(v * T(1.0f / TileMap::kTileSize));
+}
+
+template <typename T>
+T approach(T v, T target, T delta) {
+    if (v < target) return v + delta < target ? v + delta : target;
+    return v - delta > target ? v - delta : target;
+}
+
+// Adds dv to the vertical velocity of every actor in [begin, end) with
+// kActorGravity, up to max_fall.
+template <typename T>
+void apply_gravity(T* vel_y, const std::uint8_t* flags, std::uint32_t begin, std::uint32_t end, T dv, T max_fall) {
+    for (std::uint32_t i = begin; i < end; ++i) {
+        if (!(flags[i] & kActorGravity)) continue;
+        const T v = vel_y[i] + dv;
+        vel_y[i] = v < max_fall ? v : max_fall;
+    }
+}
+
+// Bits of SweepBodies::blocked: the actor stopped at a tile on that axis.
+constexpr std::uint8_t kBlockedX = 1;
+constexpr std::uint8_t kBlockedY = 2;
+
+// The actor columns a tile sweep reads and moves, and per-actor results.
+template <typename T>
+struct SweepBodies {
+    T* x;
+    T* y;
+    const T* w;
+    const T* h;
+    const T* vel_x;
+    const T* vel_y;
+    std::uint8_t* blocked;  // kBlockedX | kBlockedY
+};
+
+// The tiles that can stop a box at (x, y, w, h) moving d along one axis:
+// along the move only those ahead of the leading edge (including one it
+// already touches), across it only those the box overlaps.
+struct TileSpan {
+    int tx0, tx1, ty0, ty1;
+};
+
+template <typename T>
+inline TileSpan sweep_tile_span(T x, T y, T w, T h, T d, bool x_axis) {
+    // The sign of d is close to random from one actor to the next, so the
+    // direction picks conversion inputs rather than branching around them;
+    // tile_ceil(a) is -tile_floor(-a).
+    const bool forward = d > T();
+    const T a = x_axis ? x : y;
+    const T size = x_axis ? w : h;
+    const int ahead0 = tile_floor(forward ? a + size : a + d);
+    const int last = tile_floor(forward ? a + size + d : -a);
+    const int ahead1 = forward ? last : -last - 1;
+    if (x_axis) return {ahead0, ahead1, tile_floor(y), tile_ceil(y + h) - 1};
+    return {tile_floor(x), tile_ceil(x + w) - 1, ahead0, ahead1};
+}
+
+// Moves one box at (x, y, w, h) by d along one axis, stopping flush against
+// the first solid tile in its way; pos is its x or y. Returns whether it
+// stopped. Tiles are swept one at a time with sweep_aabb(), nearest line of
+// tiles first. A farther line can only be entered later, and every tile of a
+// line gives the same time and stop, so the first hit is the earliest.
+template <typename T>
+inline bool sweep_actor_axis(const TileMap& map, T x, T y, T w, T h, T d, bool x_axis, T& pos) {
+    const T zero{};
+    const T one(1.0f);
+    const T ts(static_cast<float>(TileMap::kTileSize));
+    if (d == zero) {
+        pos += d;
+        return false;
+    }
+    const T dx = x_axis ? d : zero;
+    const T dy = x_axis ? zero : d;
+    const TileSpan s = sweep_tile_span(x, y, w, h, d, x_axis);
+    // Along the move from the nearest line of tiles to the farthest.
+    const int near = x_axis ? (d > zero ? s.tx0 : s.tx1) : (d > zero ? s.ty0 : s.ty1);
+    const int lines = x_axis ? s.tx1 - s.tx0 + 1 : s.ty1 - s.ty0 + 1;
+    const int step = d > zero ? 1 : -1;
+    const int across0 = x_axis ? s.ty0 : s.tx0;
+    const int across1 = x_axis ? s.ty1 : s.tx1;
+    for (int k = 0, along = near; k < lines; ++k, along += step) {
+        for (int across = across0; across <= across1; ++across) {
+            const int tx = x_axis ? along : across;
+            const int ty = x_axis ? across : along;
+            if (!map.solid(tx, ty)) continue;
+            const T bx(static_cast<float>(tx * TileMap::kTileSize));
+            const T by(static_cast<float>(ty * TileMap::kTileSize));
+            const SweptHit<T> hit = sweep_aabb(x, y, w, h, dx, dy, bx, by, ts, ts);
+            if (!(hit.toi < one)) continue;
+            const T normal = x_axis ? hit.nx : hit.ny;
+            const T lo = x_axis ? bx : by;
+            // Snap flush against the tile edge rather than moving by toi * d,
+            // so resting contacts stay exact from tick to tick.
+            pos = normal < zero ? lo - (x_axis ? w : h) : lo + ts;
+            return true;
+        }
+    }
+    pos += d;
+    return false;
+}
+
+// Moves actors [begin, end) by velocity * dt, first along x and then along
+// y, each axis stopping flush against the first solid tile in the way. Both
+// axes run back to back per actor, so the columns are read once.
+template <typename T>
+void sweep_actor_range(const TileMap& map, const SweepBodies<T>& b, std::uint32_t begin, std::uint32_t end, T dt) {
+    for (std::uint32_t i = begin; i < end; ++i) {
+        const T w = b.w[i];
+        const T h = b.h[i];
+        std::uint8_t blocked = 0;
+        if (sweep_actor_axis(map, b.x[i], b.y[i], w, h, b.vel_x[i] * dt, true, b.x[i])) blocked |= kBlockedX;
+        if (sweep_actor_axis(map, b.x[i], b.y[i], w, h, b.vel_y[i] * dt, false, b.y[i])) blocked |= kBlockedY;
+        b.blocked[i] = blocked;
+    }
+}
+
+} // namespace game
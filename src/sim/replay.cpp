@@ -0,0 +1,207 @@
+#include "sim/replay.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+#include "core/fixed.hpp"
+#include "core/hash.hpp"
+#include "sim/world.hpp"
+
+namespace game {
+
+namespace {
+
+constexpr char kMagic[4] = {'S', 'G', 'R', 'P'};
+// Version 2 appended `numbers`; version 1 files end the header before it and
+// were all recorded by float builds.
+constexpr std::uint32_t kVersion = 2;
+constexpr std::size_t kVersion1HeaderSize = 48;
+
+// Which number type the recording build simulated in. Float and fixed-point
+// builds produce unrelated states, so their replays never match each other.
+enum : std::uint32_t {
+    kNumbersFloat = 0,
+    kNumbersFixed = 1,
+};
+constexpr std::uint32_t kNumbers = std::is_same<Real, Fixed>::value ? kNumbersFixed : kNumbersFloat;
+
+const char* numbers_name(std::uint32_t numbers) {
+    return numbers == kNumbersFixed ? "the fixed-point build" : "a float build";
+}
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t tick_rate;
+    std::uint32_t actor_seed;
+    std::uint32_t actor_count;
+    std::uint32_t checksum_count;
+    std::uint64_t level_hash;
+    std::uint64_t tick_count;
+    std::uint64_t final_checksum;
+    std::uint32_t numbers;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(Header) == 56, "replay header layout is part of the file format");
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+template <typename T>
+void append_pod(std::vector<std::uint8_t>& out, const T& value) {
+    const auto* p = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+void append_varint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+bool read_varint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        const std::uint8_t b = *p++;
+        v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void Replay::record(const InputState& input, const World& world) {
+    inputs.push_back(input);
+    if (inputs.size() % kChecksumInterval == 0) checksums.push_back(world.checksum());
+}
+
+void Replay::finish(const World& world) { final_checksum = world.checksum(); }
+
+std::uint64_t hash_level(const TileMap& map) {
+    const std::int32_t size[2] = {map.width(), map.height()};
+    std::uint64_t h = fnv1a64(size, sizeof size);
+    for (int y = 0; y < map.height(); ++y) {
+        for (int x = 0; x < map.width(); ++x) {
+            const Tile t = map.at(x, y);
+            h = fnv1a64(&t, sizeof t, h);
+        }
+    }
+    return h;
+}
+
+bool save_replay(const std::string& path, const Replay& replay, std::string* error) {
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof header.magic);
+    header.version = kVersion;
+    header.tick_rate = replay.tick_rate;
+    header.actor_seed = replay.actor_seed;
+    header.actor_count = replay.actor_count;
+    header.checksum_count = static_cast<std::uint32_t>(replay.checksums.size());
+    header.level_hash = replay.level_hash;
+    header.tick_count = replay.inputs.size();
+    header.final_checksum = replay.final_checksum;
+    header.numbers = kNumbers;
+
+    std::vector<std::uint8_t> out;
+    append_pod(out, header);
+    for (std::uint64_t c : replay.checksums) append_pod(out, c);
+    for (std::size_t i = 0; i < replay.inputs.size();) {
+        std::size_t run = 1;
+        while (i + run < replay.inputs.size() && replay.inputs[i + run].buttons == replay.inputs[i].buttons) ++run;
+        out.push_back(replay.inputs[i].buttons);
+        append_varint(out, run);
+        i += run;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!file) return fail(error, "cannot write " + path);
+    return true;
+}
+
+bool load_replay(const std::string& path, Replay& replay, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return fail(error, "cannot open " + path);
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Header header{};
+    if (bytes.size() < kVersion1HeaderSize) return fail(error, path + " is too short to be a replay");
+    std::memcpy(&header, bytes.data(), kVersion1HeaderSize);
+    if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0) return fail(error, path + " is not a replay");
+    if (header.version != 1 && header.version != kVersion) {
+        return fail(error, path + " has unsupported replay version");
+    }
+    const std::size_t header_size = header.version == 1 ? kVersion1HeaderSize : sizeof header;
+    if (bytes.size() < header_size) return fail(error, path + " is too short to be a replay");
+    std::memcpy(&header, bytes.data(), header_size);
+    if (header.numbers != kNumbers) {
+        return fail(error, path + " was recorded by " + numbers_name(header.numbers) + " and cannot replay in " +
+                               numbers_name(kNumbers));
+    }
+    if (header.tick_rate == 0) return fail(error, path + " has no tick rate");
+    const std::size_t checksum_bytes = static_cast<std::size_t>(header.checksum_count) * sizeof(std::uint64_t);
+    if (bytes.size() - header_size < checksum_bytes) return fail(error, path + " is truncated");
+    // Recording takes a checksum every kChecksumInterval ticks, so the
+    // checksums actually in the file bound the tick count. Checking that
+    // before trusting it keeps a corrupt count from sizing the inputs.
+    if (header.tick_count / Replay::kChecksumInterval != header.checksum_count) {
+        return fail(error, path + " has a corrupt tick count");
+    }
+
+    replay = Replay{};
+    replay.tick_rate = header.tick_rate;
+    replay.level_hash = header.level_hash;
+    replay.actor_seed = header.actor_seed;
+    replay.actor_count = header.actor_count;
+    replay.final_checksum = header.final_checksum;
+    replay.checksums.resize(header.checksum_count);
+    std::memcpy(replay.checksums.data(), bytes.data() + header_size, checksum_bytes);
+
+    const std::uint8_t* p = bytes.data() + header_size + checksum_bytes;
+    const std::uint8_t* end = bytes.data() + bytes.size();
+    replay.inputs.reserve(static_cast<std::size_t>(header.tick_count));
+    while (p != end) {
+        InputState input;
+        input.buttons = *p++;
+        std::uint64_t run;
+        if (!read_varint(p, end, run) || run > header.tick_count - replay.inputs.size()) {
+            return fail(error, path + " has a corrupt input stream");
+        }
+        replay.inputs.insert(replay.inputs.end(), static_cast<std::size_t>(run), input);
+    }
+    if (replay.inputs.size() != header.tick_count) return fail(error, path + " is truncated");
+    return true;
+}
+
+void ReplayPlayer::step(World& world) {
+    if (done()) return;
+    world.step(replay_.inputs[static_cast<std::size_t>(result_.ticks)], replay_.dt());
+    ++result_.ticks;
+    const auto tick = static_cast<std::int64_t>(result_.ticks);
+    if (result_.ticks % Replay::kChecksumInterval == 0 && next_checksum_ < replay_.checksums.size()) {
+        if (result_.diverged_at < 0 && world.checksum() != replay_.checksums[next_checksum_]) {
+            result_.diverged_at = tick;
+        }
+        ++next_checksum_;
+    }
+    if (done()) {
+        result_.final_checksum = world.checksum();
+        if (result_.diverged_at < 0 && result_.final_checksum != replay_.final_checksum) result_.diverged_at = tick;
+    }
+}
+
+ReplayResult run_replay(World& world, const Replay& replay) {
+    ReplayPlayer player(replay);
+    while (!player.done()) player.step(world);
+    return player.result();
+}
+
+} // namespace game
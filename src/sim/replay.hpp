@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sim/input.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+class World;
+
+// A recorded play session: how the world was set up plus the input of every
+// tick. Because the simulation is deterministic on a given binary, feeding
+// the inputs back through an identically set up World reproduces the session
+// exactly. Periodic state checksums let a replay report the first point it
+// diverged instead of silently playing something else.
+struct Replay {
+    static constexpr std::uint32_t kChecksumInterval = 600;  // ticks (5 s at 120 Hz)
+
+    // Setup. The caller builds the world; level_hash (see hash_level) lets a
+    // replay refuse to run against a different level.
+    std::uint32_t tick_rate = 120;
+    std::uint64_t level_hash = 0;
+    std::uint32_t actor_seed = 0;
+    std::uint32_t actor_count = 0;
+
+    std::vector<InputState> inputs;        // one per tick
+    std::vector<std::uint64_t> checksums;  // World::checksum() after every kChecksumInterval ticks
+    std::uint64_t final_checksum = 0;
+
+    float dt() const { return static_cast<float>(1.0 / tick_rate); }
+
+    // Call after each World::step() while recording.
+    void record(const InputState& input, const World& world);
+    // Seals the recording with the world's final state.
+    void finish(const World& world);
+};
+
+std::uint64_t hash_level(const TileMap& map);
+
+// On disk: a fixed header, the checksums, then the inputs as (buttons,
+// varint run length) pairs. Held buttons change rarely, so ten minutes of
+// play is a few kilobytes. The header records whether the build simulated in
+// float or fixed point, and loading refuses a replay from the other kind.
+bool save_replay(const std::string& path, const Replay& replay, std::string* error);
+bool load_replay(const std::string& path, Replay& replay, std::string* error);
+
+struct ReplayResult {
+    std::uint64_t ticks = 0;
+    // Tick after which the first mismatching checksum was taken, or -1.
+    std::int64_t diverged_at = -1;
+    std::uint64_t final_checksum = 0;
+    bool matched() const { return diverged_at < 0; }
+};
+
+// Feeds a replay to a World one tick at a time, checking checksums as it
+// goes. `world` must be freshly set up the way the recording's was. The game
+// drives this from its frame loop; run_replay() is the uncapped version.
+class ReplayPlayer {
+public:
+    explicit ReplayPlayer(const Replay& replay) : replay_(replay) {}
+
+    bool done() const { return result_.ticks == replay_.inputs.size(); }
+    void step(World& world);
+    // Complete (including the final checksum) once done().
+    const ReplayResult& result() const { return result_; }
+
+private:
+    const Replay& replay_;
+    ReplayResult result_;
+    std::size_t next_checksum_ = 0;
+};
+
+// Steps `world` through every recorded input as fast as it will go.
+ReplayResult run_replay(World& world, const Replay& replay);
+
+} // namespace game
@@ -0,0 +1,114 @@
+#include "sim/rewind_buffer.hpp"
+
+#include <cstring>
+
+namespace game {
+
+namespace {
+
+// Reverts `count` edits stored at `edits`, newest first, so a tile edited
+// twice ends up as it was before the first edit. They are read with memcpy
+// because snapshots are packed without alignment.
+void undo(World& world, const std::uint8_t* edits, std::size_t count) {
+    while (count-- > 0) {
+        TileEdit e;
+        std::memcpy(&e, edits + count * sizeof(TileEdit), sizeof e);
+        world.map().set(e.tx, e.ty, e.before);
+    }
+}
+
+} // namespace
+
+RewindBuffer::RewindBuffer(std::size_t budget_bytes, std::size_t max_snapshots)
+    : bytes_(budget_bytes), entries_(max_snapshots < 1 ? 1 : max_snapshots) {}
+
+std::size_t RewindBuffer::bytes_used() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count_; ++i) total += end_of(entry(i)) - entry(i).offset;
+    return total;
+}
+
+void RewindBuffer::evict_oldest() {
+    first_ = (first_ + 1) % entries_.size();
+    --count_;
+}
+
+std::size_t RewindBuffer::end_of(const Entry& e) {
+    return e.offset + e.state_size + e.edit_count * sizeof(TileEdit);
+}
+
+bool RewindBuffer::edits_lost(const World& world) {
+    const std::uint64_t drops = world.tile_edits().dropped();
+    if (drops == edit_drops_) return false;
+    edit_drops_ = drops;
+    return true;
+}
+
+void RewindBuffer::capture(World& world) {
+    // Edits the journal could not hold are missing from the deltas, so no
+    // held snapshot can be rewound to any more. The new one has nothing
+    // older to rewind to, so it needs no deltas either.
+    std::size_t edit_count = world.tile_edits().size();
+    if (edits_lost(world)) {
+        count_ = 0;
+        edit_count = 0;
+    }
+    const std::size_t state_size = world.state_bytes();
+    const std::size_t size = state_size + edit_count * sizeof(TileEdit);
+    if (size > bytes_.size()) {
+        ++dropped_;
+        count_ = 0;
+        world.clear_tile_edits();
+        return;
+    }
+
+    // Append after the newest snapshot and evict whatever the new one
+    // overlaps. Live snapshots follow the write position in age order, with
+    // at most one wrap, so the ones in the way are always the oldest. When
+    // the tail is too short the write restarts at 0, and the snapshots left
+    // in the tail (the oldest) go first, then those at the start it overlaps.
+    std::size_t offset = count_ > 0 ? end_of(entry(count_ - 1)) : 0;
+    if (offset + size > bytes_.size()) {
+        while (count_ > 0 && entry(0).offset >= offset) evict_oldest();
+        offset = 0;
+    }
+    while (count_ > 0) {
+        const Entry& oldest = entry(0);
+        if (oldest.offset >= offset + size || end_of(oldest) <= offset) break;
+        evict_oldest();
+    }
+    if (count_ == entries_.size()) evict_oldest();
+
+    entry(count_++) = {world.tick(), offset, state_size, edit_count};
+    world.save_state(&bytes_[offset]);
+    if (edit_count > 0) {
+        std::memcpy(&bytes_[offset + state_size], world.tile_edits().data(), edit_count * sizeof(TileEdit));
+    }
+    world.clear_tile_edits();
+}
+
+bool RewindBuffer::restore(World& world, std::uint64_t tick) {
+    if (edits_lost(world)) count_ = 0;
+    std::size_t target = count_;
+    for (std::size_t i = count_; i-- > 0;) {
+        if (entry(i).tick == tick) {
+            target = i;
+            break;
+        }
+    }
+    if (target == count_) return false;
+
+    // Tiles go back by undoing every edit made after the target snapshot:
+    // the ones not captured yet, then each later snapshot's.
+    undo(world, reinterpret_cast<const std::uint8_t*>(world.tile_edits().data()), world.tile_edits().size());
+    world.clear_tile_edits();
+    for (std::size_t i = count_ - 1; i > target; --i) {
+        const Entry& e = entry(i);
+        undo(world, &bytes_[e.offset + e.state_size], e.edit_count);
+    }
+    world.load_state(&bytes_[entry(target).offset]);
+    count_ = target + 1;
+    return true;
+}
+
+} // namespace game
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/world.hpp"
+
+namespace game {
+
+// The world's state after each of the most recent ticks, for instant rewind
+// and rollback.
+//
+// A snapshot is World::save_state()'s flat copy of the actor and particle
+// arrays followed by the tile edits journaled since the previous snapshot,
+// so tiles rewind by undoing deltas instead of copying the map. Snapshots
+// are packed back to back in one byte ring allocated up front; the oldest
+// are evicted to make room, so how many ticks are held depends on how big
+// the world is. capture() and restore() never allocate.
+class RewindBuffer {
+public:
+    // Holds at most max_snapshots snapshots in budget_bytes of memory.
+    RewindBuffer(std::size_t budget_bytes, std::size_t max_snapshots);
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    // Ticks (World::tick() values) that restore() can return to; only valid
+    // when not empty().
+    std::uint64_t oldest_tick() const { return entry(0).tick; }
+    std::uint64_t newest_tick() const { return entry(count_ - 1).tick; }
+    // Bytes the held snapshots take up.
+    std::size_t bytes_used() const;
+    // Captures that did not fit the budget even with the ring emptied. The
+    // ring is cleared when that happens, since it would have a gap.
+    std::uint64_t dropped() const { return dropped_; }
+
+    // Call after every World::step(). Takes and clears the world's tile edit
+    // journal. If the journal overflowed since the last call, the held
+    // snapshots are forgotten, since their tile deltas are incomplete.
+    void capture(World& world);
+
+    // Puts `world` back to how it was after `tick` and forgets every later
+    // snapshot, so the next capture() continues the new timeline. Returns
+    // false, leaving the world alone, if the tick is not held (or the edit
+    // journal overflowed since the last capture, which forgets them all).
+    bool restore(World& world, std::uint64_t tick);
+
+    void clear() { count_ = 0; }
+
+private:
+    struct Entry {
+        std::uint64_t tick;
+        std::size_t offset;      // into bytes_
+        std::size_t state_size;  // World state, then edit_count TileEdits
+        std::size_t edit_count;
+    };
+
+    // The i-th held snapshot, oldest first.
+    Entry& entry(std::size_t i) { return entries_[(first_ + i) % entries_.size()]; }
+    const Entry& entry(std::size_t i) const { return entries_[(first_ + i) % entries_.size()]; }
+    void evict_oldest();
+    static std::size_t end_of(const Entry& e);
+    // Whether the world's edit journal dropped edits since the last call.
+    bool edits_lost(const World& world);
+
+    std::vector<std::uint8_t> bytes_;
+    std::vector<Entry> entries_;
+    std::size_t first_ = 0;
+    std::size_t count_ = 0;
+    std::uint64_t dropped_ = 0;
+    std::uint64_t edit_drops_ = 0;  // world.tile_edits().dropped() last seen
+};
+
+} // namespace game
@@ -0,0 +1,49 @@
+#include "sim/spatial_grid.hpp"
+
+#include <algorithm>
+
+namespace game {
+
+void SpatialGrid::reset(float world_w, float world_h, float cell_size) {
+    cell_size_ = cell_size;
+    inv_cell_ = 1.0f / cell_size;
+    cells_x_ = std::max(1, static_cast<int>(std::ceil(world_w * inv_cell_)));
+    cells_y_ = std::max(1, static_cast<int>(std::ceil(world_h * inv_cell_)));
+    cell_start_.assign(static_cast<std::size_t>(cells_x_) * cells_y_ + 1, 0);
+    entries_.clear();
+}
+
+void SpatialGrid::build(const float* x, const float* y, const float* w, const float* h, std::size_t n) {
+    build_columns(x, y, w, h, n);
+}
+
+void SpatialGrid::build(const Fixed* x, const Fixed* y, const Fixed* w, const Fixed* h, std::size_t n) {
+    build_columns(x, y, w, h, n);
+}
+
+template <typename T>
+void SpatialGrid::build_columns(const T* x, const T* y, const T* w, const T* h, std::size_t n) {
+    std::fill(cell_start_.begin(), cell_start_.end(), 0u);
+    cell_of_.resize(n);
+    entries_.resize(n);
+    max_w_ = 0.0f;
+    max_h_ = 0.0f;
+
+    // Count actors per cell, shifted by one so the prefix sum below turns
+    // counts into start offsets in place.
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t c = static_cast<std::uint32_t>(cell_y(to_float(y[i])) * cells_x_ + cell_x(to_float(x[i])));
+        cell_of_[i] = c;
+        ++cell_start_[c + 1];
+        max_w_ = std::max(max_w_, to_float(w[i]));
+        max_h_ = std::max(max_h_, to_float(h[i]));
+    }
+    for (std::size_t c = 1; c < cell_start_.size(); ++c) cell_start_[c] += cell_start_[c - 1];
+
+    // Scatter, using the start offsets as write cursors, then shift them back.
+    for (std::size_t i = 0; i < n; ++i) entries_[cell_start_[cell_of_[i]]++] = static_cast<std::uint32_t>(i);
+    for (std::size_t c = cell_start_.size() - 1; c > 0; --c) cell_start_[c] = cell_start_[c - 1];
+    cell_start_[0] = 0;
+}
+
+} // namespace game
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/fixed.hpp"
+#include "core/math.hpp"
+
+namespace game {
+
+// Uniform broad-phase grid over a bounded level, rebuilt from the actor
+// arrays every tick.
+//
+// Each actor is filed under the single cell containing its top-left corner,
+// so build() is a counting sort and a query never reports an actor twice.
+// Queries widen the box by the largest actor extent seen at build time to
+// catch actors whose corner sits in a neighbouring cell. Candidates are only
+// near the box; callers still run the exact overlap test.
+class SpatialGrid {
+public:
+    void reset(float world_w, float world_h, float cell_size);
+
+    void build(const float* x, const float* y, const float* w, const float* h, std::size_t n);
+    void build(const Fixed* x, const Fixed* y, const Fixed* w, const Fixed* h, std::size_t n);
+    // Sizes the per-actor arrays so builds of up to n actors never reallocate.
+    void reserve(std::size_t n) {
+        cell_of_.reserve(n);
+        entries_.reserve(n);
+    }
+
+    // Calls visit(slot) for every actor filed in a cell the box can reach.
+    template <typename Visit>
+    void query(const Aabb& box, Visit&& visit) const {
+        const int cx0 = cell_x(box.x - max_w_);
+        const int cy0 = cell_y(box.y - max_h_);
+        const int cx1 = cell_x(box.x + box.w);
+        const int cy1 = cell_y(box.y + box.h);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            const std::uint32_t* row = cell_start_.data() + static_cast<std::size_t>(cy) * cells_x_;
+            for (std::uint32_t e = row[cx0]; e < row[cx1 + 1]; ++e) visit(entries_[e]);
+        }
+    }
+
+    int cells_x() const { return cells_x_; }
+    int cells_y() const { return cells_y_; }
+    float cell_size() const { return cell_size_; }
+
+private:
+    template <typename T>
+    void build_columns(const T* x, const T* y, const T* w, const T* h, std::size_t n);
+
+    int cell_x(float v) const { return clamp_cell(static_cast<int>(std::floor(v * inv_cell_)), cells_x_); }
+    int cell_y(float v) const { return clamp_cell(static_cast<int>(std::floor(v * inv_cell_)), cells_y_); }
+    static int clamp_cell(int c, int n) { return c < 0 ? 0 : (c >= n ? n - 1 : c); }
+
+    float cell_size_ = 64.0f;
+    float inv_cell_ = 1.0f / 64.0f;
+    int cells_x_ = 1;
+    int cells_y_ = 1;
+    float max_w_ = 0.0f;
+    float max_h_ = 0.0f;
+
+    // cell_start_[c] .. cell_start_[c + 1] indexes entries_ for cell c. Cells
+    // are row-major, so one row's cells form a contiguous entry range.
+    std::vector<std::uint32_t> cell_start_;
+    std::vector<std::uint32_t> entries_;
+    std::vector<std::uint32_t> cell_of_;
+};
+
+} // namespace game
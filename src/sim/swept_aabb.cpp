@@ -0,0 +1,222 @@
+#include "sim/swept_aabb.hpp"
+
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GAME_SWEEP_X86 1
+#else
+#define GAME_SWEEP_X86 0
+#endif
+
+namespace game {
+
+template <typename T>
+void BasicSweptAabbBatch<T>::clear() {
+    ax.clear();
+    ay.clear();
+    aw.clear();
+    ah.clear();
+    dx.clear();
+    dy.clear();
+    bx.clear();
+    by.clear();
+    bw.clear();
+    bh.clear();
+    owner.clear();
+}
+
+template <typename T>
+void BasicSweptAabbBatch<T>::resize(std::size_t n) {
+    ax.resize(n);
+    ay.resize(n);
+    aw.resize(n);
+    ah.resize(n);
+    dx.resize(n);
+    dy.resize(n);
+    bx.resize(n);
+    by.resize(n);
+    bw.resize(n);
+    bh.resize(n);
+    owner.resize(n);
+}
+
+template <typename T>
+void BasicSweptAabbBatch<T>::reserve(std::size_t n) {
+    ax.reserve(n);
+    ay.reserve(n);
+    aw.reserve(n);
+    ah.reserve(n);
+    dx.reserve(n);
+    dy.reserve(n);
+    bx.reserve(n);
+    by.reserve(n);
+    bw.reserve(n);
+    bh.reserve(n);
+    owner.reserve(n);
+}
+
+template struct BasicSweptAabbBatch<float>;
+template struct BasicSweptAabbBatch<Fixed>;
+
+namespace {
+
+constexpr float kInf = std::numeric_limits<float>::infinity();
+
+// The vector paths mirror sweep_aabb() operation for operation.
+template <typename T>
+inline void sweep_one(const BasicSweptAabbBatch<T>& b, std::size_t i, BasicSweptContacts<T>& out) {
+    const SweptHit<T> hit =
+        sweep_aabb(b.ax[i], b.ay[i], b.aw[i], b.ah[i], b.dx[i], b.dy[i], b.bx[i], b.by[i], b.bw[i], b.bh[i]);
+    out.toi[i] = hit.toi;
+    out.nx[i] = hit.nx;
+    out.ny[i] = hit.ny;
+}
+
+template <typename T>
+void sweep_scalar(const BasicSweptAabbBatch<T>& b, std::size_t begin, std::size_t end, BasicSweptContacts<T>& out) {
+    for (std::size_t i = begin; i < end; ++i) sweep_one(b, i, out);
+}
+
+#if GAME_SWEEP_X86
+
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline void sweep_axis4(__m128 a, __m128 d, __m128 lo, __m128 hi, __m128& entry, __m128& exit) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 inf = _mm_set1_ps(kInf);
+    const __m128 neg_inf = _mm_set1_ps(-kInf);
+    const __m128 t0 = _mm_div_ps(_mm_sub_ps(lo, a), d);
+    const __m128 t1 = _mm_div_ps(_mm_sub_ps(hi, a), d);
+    const __m128 moving = _mm_cmpneq_ps(d, zero);
+    const __m128 inside = _mm_and_ps(_mm_cmpgt_ps(a, lo), _mm_cmplt_ps(a, hi));
+    entry = select4(moving, _mm_min_ps(t0, t1), select4(inside, neg_inf, inf));
+    exit = select4(moving, _mm_max_ps(t0, t1), select4(inside, inf, neg_inf));
+}
+
+std::size_t sweep_sse2(const SweptAabbBatch& b, SweptContacts& out) {
+    const std::size_t n = b.size() & ~std::size_t{3};
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 neg_one = _mm_set1_ps(-1.0f);
+    for (std::size_t i = 0; i < n; i += 4) {
+        const __m128 ax = _mm_loadu_ps(&b.ax[i]);
+        const __m128 ay = _mm_loadu_ps(&b.ay[i]);
+        const __m128 dx = _mm_loadu_ps(&b.dx[i]);
+        const __m128 dy = _mm_loadu_ps(&b.dy[i]);
+        const __m128 bx = _mm_loadu_ps(&b.bx[i]);
+        const __m128 by = _mm_loadu_ps(&b.by[i]);
+
+        __m128 entry_x, exit_x, entry_y, exit_y;
+        sweep_axis4(ax, dx, _mm_sub_ps(bx, _mm_loadu_ps(&b.aw[i])), _mm_add_ps(bx, _mm_loadu_ps(&b.bw[i])),
+                    entry_x, exit_x);
+        sweep_axis4(ay, dy, _mm_sub_ps(by, _mm_loadu_ps(&b.ah[i])), _mm_add_ps(by, _mm_loadu_ps(&b.bh[i])),
+                    entry_y, exit_y);
+
+        const __m128 entry = _mm_max_ps(entry_x, entry_y);
+        const __m128 exit = _mm_min_ps(exit_x, exit_y);
+        const __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(entry, exit), _mm_cmpge_ps(entry, zero)),
+                                      _mm_cmplt_ps(entry, one));
+        const __m128 x_axis = _mm_cmpgt_ps(entry_x, entry_y);
+        const __m128 nx = select4(_mm_cmpgt_ps(dx, zero), neg_one, one);
+        const __m128 ny = select4(_mm_cmpgt_ps(dy, zero), neg_one, one);
+
+        _mm_storeu_ps(&out.toi[i], select4(hit, entry, one));
+        _mm_storeu_ps(&out.nx[i], _mm_and_ps(_mm_and_ps(hit, x_axis), nx));
+        _mm_storeu_ps(&out.ny[i], _mm_and_ps(_mm_andnot_ps(x_axis, hit), ny));
+    }
+    return n;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GAME_TARGET_AVX2 __attribute__((target("avx2")))
+
+GAME_TARGET_AVX2 inline void sweep_axis8(__m256 a, __m256 d, __m256 lo, __m256 hi, __m256& entry, __m256& exit) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 inf = _mm256_set1_ps(kInf);
+    const __m256 neg_inf = _mm256_set1_ps(-kInf);
+    const __m256 t0 = _mm256_div_ps(_mm256_sub_ps(lo, a), d);
+    const __m256 t1 = _mm256_div_ps(_mm256_sub_ps(hi, a), d);
+    const __m256 moving = _mm256_cmp_ps(d, zero, _CMP_NEQ_UQ);
+    const __m256 inside = _mm256_and_ps(_mm256_cmp_ps(a, lo, _CMP_GT_OQ), _mm256_cmp_ps(a, hi, _CMP_LT_OQ));
+    entry = _mm256_blendv_ps(_mm256_blendv_ps(inf, neg_inf, inside), _mm256_min_ps(t0, t1), moving);
+    exit = _mm256_blendv_ps(_mm256_blendv_ps(neg_inf, inf, inside), _mm256_max_ps(t0, t1), moving);
+}
+
+GAME_TARGET_AVX2 std::size_t sweep_avx2(const SweptAabbBatch& b, SweptContacts& out) {
+    const std::size_t n = b.size() & ~std::size_t{7};
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 neg_one = _mm256_set1_ps(-1.0f);
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __m256 ax = _mm256_loadu_ps(&b.ax[i]);
+        const __m256 ay = _mm256_loadu_ps(&b.ay[i]);
+        const __m256 dx = _mm256_loadu_ps(&b.dx[i]);
+        const __m256 dy = _mm256_loadu_ps(&b.dy[i]);
+        const __m256 bx = _mm256_loadu_ps(&b.bx[i]);
+        const __m256 by = _mm256_loadu_ps(&b.by[i]);
+
+        __m256 entry_x, exit_x, entry_y, exit_y;
+        sweep_axis8(ax, dx, _mm256_sub_ps(bx, _mm256_loadu_ps(&b.aw[i])),
+                    _mm256_add_ps(bx, _mm256_loadu_ps(&b.bw[i])), entry_x, exit_x);
+        sweep_axis8(ay, dy, _mm256_sub_ps(by, _mm256_loadu_ps(&b.ah[i])),
+                    _mm256_add_ps(by, _mm256_loadu_ps(&b.bh[i])), entry_y, exit_y);
+
+        const __m256 entry = _mm256_max_ps(entry_x, entry_y);
+        const __m256 exit = _mm256_min_ps(exit_x, exit_y);
+        const __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(entry, exit, _CMP_LT_OQ), _mm256_cmp_ps(entry, zero, _CMP_GE_OQ)),
+            _mm256_cmp_ps(entry, one, _CMP_LT_OQ));
+        const __m256 x_axis = _mm256_cmp_ps(entry_x, entry_y, _CMP_GT_OQ);
+        const __m256 nx = _mm256_blendv_ps(one, neg_one, _mm256_cmp_ps(dx, zero, _CMP_GT_OQ));
+        const __m256 ny = _mm256_blendv_ps(one, neg_one, _mm256_cmp_ps(dy, zero, _CMP_GT_OQ));
+
+        _mm256_storeu_ps(&out.toi[i], _mm256_blendv_ps(one, entry, hit));
+        _mm256_storeu_ps(&out.nx[i], _mm256_and_ps(_mm256_and_ps(hit, x_axis), nx));
+        _mm256_storeu_ps(&out.ny[i], _mm256_and_ps(_mm256_andnot_ps(x_axis, hit), ny));
+    }
+    return n;
+}
+#define GAME_SWEEP_AVX2 1
+#else
+#define GAME_SWEEP_AVX2 0
+#endif
+
+#endif // GAME_SWEEP_X86
+
+} // namespace
+
+void sweep_aabbs(const SweptAabbBatch& batch, SweptContacts& out, SimdLevel level) {
+    const std::size_t n = batch.size();
+    out.toi.resize(n);
+    out.nx.resize(n);
+    out.ny.resize(n);
+
+    std::size_t done = 0;
+#if GAME_SWEEP_X86
+#if GAME_SWEEP_AVX2
+    if (level == SimdLevel::Avx2) {
+        done = sweep_avx2(batch, out);
+    } else
+#endif
+    if (level != SimdLevel::Scalar) {
+        done = sweep_sse2(batch, out);
+    }
+#else
+    (void)level;
+#endif
+    // Remainder lanes (and the whole batch on the scalar path).
+    sweep_scalar(batch, done, n, out);
+}
+
+void sweep_aabbs(const BasicSweptAabbBatch<Fixed>& batch, BasicSweptContacts<Fixed>& out) {
+    const std::size_t n = batch.size();
+    out.toi.resize(n);
+    out.nx.resize(n);
+    out.ny.resize(n);
+    sweep_scalar(batch, 0, n, out);
+}
+
+} // namespace game
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "core/cpu_features.hpp"
+#include "core/fixed.hpp"
+
+namespace game {
+
+// Batch of moving-box vs static-box sweeps in structure-of-arrays form. Each
+// entry pairs an actor box (a*) moving by (dx, dy) this tick with one static
+// box (b*), typically a solid tile. `owner` is free for the caller, e.g. the
+// actor's dense slot. T is float or Fixed.
+template <typename T>
+struct BasicSweptAabbBatch {
+    std::vector<T> ax, ay, aw, ah;
+    std::vector<T> dx, dy;
+    std::vector<T> bx, by, bw, bh;
+    std::vector<std::uint32_t> owner;
+
+    std::size_t size() const { return ax.size(); }
+    void clear();
+    void resize(std::size_t n);
+    void reserve(std::size_t n);
+    void push(std::uint32_t owner_id, T a_x, T a_y, T a_w, T a_h, T d_x, T d_y, T b_x, T b_y, T b_w, T b_h) {
+        ax.push_back(a_x);
+        ay.push_back(a_y);
+        aw.push_back(a_w);
+        ah.push_back(a_h);
+        dx.push_back(d_x);
+        dy.push_back(d_y);
+        bx.push_back(b_x);
+        by.push_back(b_y);
+        bw.push_back(b_w);
+        bh.push_back(b_h);
+        owner.push_back(owner_id);
+    }
+};
+
+extern template struct BasicSweptAabbBatch<float>;
+extern template struct BasicSweptAabbBatch<Fixed>;
+using SweptAabbBatch = BasicSweptAabbBatch<float>;
+
+// Per-entry results: time of impact as a fraction of the move (1 when there
+// is no hit) and the contact normal on the static box (0, 0 when no hit).
+template <typename T>
+struct BasicSweptContacts {
+    std::vector<T> toi;
+    std::vector<T> nx, ny;
+
+    void reserve(std::size_t n) {
+        toi.reserve(n);
+        nx.reserve(n);
+        ny.reserve(n);
+    }
+};
+
+using SweptContacts = BasicSweptContacts<float>;
+
+// One moving box against one static box: the time of impact and contact
+// normal sweep_aabbs() stores for an entry, computed with exactly the
+// operations its scalar path runs, so callers that reduce hits as they find
+// them get bit-identical results without filling a batch.
+template <typename T>
+struct SweptHit {
+    T toi, nx, ny;
+};
+
+// What a slab that is never (or always) entered reports as its entry time.
+template <typename T>
+constexpr T sweep_never() {
+    if constexpr (std::is_same_v<T, Fixed>) {
+        return kFixedMax;
+    } else {
+        return std::numeric_limits<T>::infinity();
+    }
+}
+
+// Slab test on one axis: the interval of move fractions during which the
+// moving box's min corner lies inside the Minkowski-expanded static box
+// (lo, hi). A zero displacement is either always inside or never. min/max
+// use the SSE semantics (a < b ? a : b) so any NaN behaves as in the vector
+// paths.
+template <typename T>
+inline void sweep_slab(T a, T d, T lo, T hi, T& entry, T& exit) {
+    if (d != T()) {
+        const T t0 = (lo - a) / d;
+        const T t1 = (hi - a) / d;
+        entry = t0 < t1 ? t0 : t1;
+        exit = t0 > t1 ? t0 : t1;
+    } else {
+        const bool inside = a > lo && a < hi;
+        entry = inside ? -sweep_never<T>() : sweep_never<T>();
+        exit = inside ? sweep_never<T>() : -sweep_never<T>();
+    }
+}
+
+template <typename T>
+inline SweptHit<T> sweep_aabb(T ax, T ay, T aw, T ah, T dx, T dy, T bx, T by, T bw, T bh) {
+    const T zero{}, one(1.0f);
+    T entry_x, exit_x, entry_y, exit_y;
+    sweep_slab(ax, dx, bx - aw, bx + bw, entry_x, exit_x);
+    sweep_slab(ay, dy, by - ah, by + bh, entry_y, exit_y);
+
+    const T entry = entry_x > entry_y ? entry_x : entry_y;
+    const T exit = exit_x < exit_y ? exit_x : exit_y;
+    const bool hit = entry < exit && entry >= zero && entry < one;
+    const bool x_axis = entry_x > entry_y;
+    return {hit ? entry : one, hit && x_axis ? (dx > zero ? -one : one) : zero,
+            hit && !x_axis ? (dy > zero ? -one : one) : zero};
+}
+
+// Sweeps every entry of the batch. All levels run the same sequence of IEEE
+// operations (no reciprocal approximations, no fused multiply-add), so their
+// results are bit-identical; the level only changes how many lanes run at once.
+void sweep_aabbs(const SweptAabbBatch& batch, SweptContacts& out, SimdLevel level);
+
+inline void sweep_aabbs(const SweptAabbBatch& batch, SweptContacts& out) {
+    sweep_aabbs(batch, out, active_simd_level());
+}
+
+// Fixed-point batches run the same code as the scalar float path, on
+// integers.
+void sweep_aabbs(const BasicSweptAabbBatch<Fixed>& batch, BasicSweptContacts<Fixed>& out);
+
+} // namespace game
@@ -0,0 +1,229 @@
+#include "sim/tile_sweep.hpp"
+
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define GAME_TILE_SWEEP_AVX2 1
+#define GAME_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GAME_TILE_SWEEP_AVX2 0
+#endif
+
+namespace game {
+
+namespace {
+
+#if GAME_TILE_SWEEP_AVX2
+
+// Tile coordinates scale to pixels with a shift.
+static_assert(TileMap::kTileSize == 16, "tile sweeps shift tile coordinates by 4");
+constexpr int kTileShift = 4;
+// Gathers index solid rows in 32-bit words from the first chunk's.
+static_assert(sizeof(TileChunk) % sizeof(std::uint32_t) == 0, "chunks must be a whole number of words");
+constexpr int kChunkWords = static_cast<int>(sizeof(TileChunk) / sizeof(std::uint32_t));
+
+// Whether the map's tables fit the 32-bit gather indices.
+bool gatherable(const TileMap& map) {
+    constexpr std::size_t kMaxIndex = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+    return map.chunk_storage_size() != 0 && map.slot_count() <= kMaxIndex &&
+           map.chunk_storage_size() <= kMaxIndex / kChunkWords;
+}
+
+// Moves the actors in `lanes` by d along one axis with sweep_actor_axis().
+unsigned sweep_lanes(const TileMap& map, const SweepBodies<float>& b, std::uint32_t i, unsigned lanes, float dt,
+                     bool x_axis, unsigned blocked) {
+    const float* vel = x_axis ? b.vel_x : b.vel_y;
+    float* pos = x_axis ? b.x : b.y;
+    for (unsigned l = 0; l < 8; ++l) {
+        if (!(lanes & (1u << l))) continue;
+        const std::uint32_t j = i + l;
+        if (sweep_actor_axis(map, b.x[j], b.y[j], b.w[j], b.h[j], vel[j] * dt, x_axis, pos[j])) {
+            blocked |= 1u << l;
+        } else {
+            blocked &= ~(1u << l);
+        }
+    }
+    return blocked;
+}
+
+// tile_floor() and tile_ceil() per lane.
+GAME_TARGET_AVX2 inline __m256i tile_floor8(__m256 v) {
+    const __m256 t = _mm256_mul_ps(v, _mm256_set1_ps(1.0f / TileMap::kTileSize));
+    const __m256i i = _mm256_cvttps_epi32(t);
+    return _mm256_add_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(t, _mm256_cvtepi32_ps(i), _CMP_LT_OQ)));
+}
+GAME_TARGET_AVX2 inline __m256i tile_ceil8(__m256 v) {
+    const __m256 t = _mm256_mul_ps(v, _mm256_set1_ps(1.0f / TileMap::kTileSize));
+    const __m256i i = _mm256_cvttps_epi32(t);
+    return _mm256_sub_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(t, _mm256_cvtepi32_ps(i), _CMP_GT_OQ)));
+}
+
+GAME_TARGET_AVX2 inline __m256 tile_pixels8(__m256i t) {
+    return _mm256_cvtepi32_ps(_mm256_slli_epi32(t, kTileShift));
+}
+
+// solid(tx, ty) in bit 0 and solid(tx + 1, ty) in bit 1 for the lanes in
+// `need`, gathered from one row word. Needed lanes whose pair is not inside
+// one chunk of the map are added to `missed` for the scalar path.
+GAME_TARGET_AVX2 inline __m256i solid_pairs8(const TileMap& map, __m256i tx, __m256i ty, __m256i need,
+                                             __m256i& missed) {
+    const __m256i mask = _mm256_set1_epi32(TileChunk::kMask);
+    const __m256i none = _mm256_set1_epi32(-1);
+    const __m256i col = _mm256_and_si256(tx, mask);
+    const __m256i inside = _mm256_andnot_si256(
+        _mm256_cmpeq_epi32(col, mask),
+        _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(tx, none), _mm256_cmpgt_epi32(ty, none)),
+                         _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(map.width() - 1), tx),
+                                          _mm256_cmpgt_epi32(_mm256_set1_epi32(map.height()), ty))));
+    const __m256i ok = _mm256_and_si256(need, inside);
+    missed = _mm256_or_si256(missed, _mm256_andnot_si256(inside, need));
+    const __m256i chunk_row = _mm256_srai_epi32(ty, TileChunk::kShift);
+    const __m256i chunk = _mm256_add_epi32(_mm256_mullo_epi32(chunk_row, _mm256_set1_epi32(map.chunks_x())),
+                                           _mm256_srai_epi32(tx, TileChunk::kShift));
+    const __m256i slot = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                                                     reinterpret_cast<const int*>(map.slot_table()), chunk, ok, 4);
+    const __m256i word = _mm256_add_epi32(_mm256_mullo_epi32(slot, _mm256_set1_epi32(kChunkWords)),
+                                          _mm256_and_si256(ty, mask));
+    const __m256i row = _mm256_mask_i32gather_epi32(
+        _mm256_setzero_si256(), reinterpret_cast<const int*>(map.chunk_storage()[0].solid_rows.data()), word, ok, 4);
+    return _mm256_and_si256(_mm256_srlv_epi32(row, col), _mm256_set1_epi32(3));
+}
+
+GAME_TARGET_AVX2 inline __m256 bit8(__m256i bits, int bit) {
+    const __m256i b = _mm256_set1_epi32(bit);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(bits, b), b));
+}
+
+// Whether a box at a of `size` moving by d first touches the line of tiles
+// at pixel lo within the move, as sweep_aabb() decides it.
+GAME_TARGET_AVX2 inline __m256 line_hit8(__m256 a, __m256 d, __m256 size, __m256 lo) {
+    const __m256 ts = _mm256_set1_ps(static_cast<float>(TileMap::kTileSize));
+    const __m256 t0 = _mm256_div_ps(_mm256_sub_ps(_mm256_sub_ps(lo, size), a), d);
+    const __m256 t1 = _mm256_div_ps(_mm256_sub_ps(_mm256_add_ps(lo, ts), a), d);
+    const __m256 entry = _mm256_min_ps(t0, t1);
+    const __m256 exit = _mm256_max_ps(t0, t1);
+    return _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(entry, exit, _CMP_LT_OQ),
+                                       _mm256_cmp_ps(entry, _mm256_setzero_ps(), _CMP_GE_OQ)),
+                         _mm256_cmp_ps(entry, _mm256_set1_ps(1.0f), _CMP_LT_OQ));
+}
+
+// Whether a box at c of `size` overlaps the tile at pixel lo across the move.
+GAME_TARGET_AVX2 inline __m256 overlaps8(__m256 c, __m256 size, __m256 lo) {
+    const __m256 ts = _mm256_set1_ps(static_cast<float>(TileMap::kTileSize));
+    return _mm256_and_ps(_mm256_cmp_ps(c, _mm256_sub_ps(lo, size), _CMP_GT_OQ),
+                         _mm256_cmp_ps(c, _mm256_add_ps(lo, ts), _CMP_LT_OQ));
+}
+
+// One axis of actors [i, i + 8). Each lane looks at up to two lines of tiles
+// along the move (A, and B = A + 1 farther from the origin) and two tiles
+// across it, and keeps the nearer line that stops it. Returns the lanes that
+// stopped.
+GAME_TARGET_AVX2 unsigned sweep_axis8(const TileMap& map, const SweepBodies<float>& b, std::uint32_t i, float dt,
+                                      bool x_axis) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 ts = _mm256_set1_ps(static_cast<float>(TileMap::kTileSize));
+    const __m256i one = _mm256_set1_epi32(1);
+    float* pos = (x_axis ? b.x : b.y) + i;
+    const __m256 a = _mm256_loadu_ps(pos);
+    const __m256 c = _mm256_loadu_ps((x_axis ? b.y : b.x) + i);
+    const __m256 size = _mm256_loadu_ps((x_axis ? b.w : b.h) + i);
+    const __m256 across_size = _mm256_loadu_ps((x_axis ? b.h : b.w) + i);
+    const __m256 d = _mm256_mul_ps(_mm256_loadu_ps((x_axis ? b.vel_x : b.vel_y) + i), _mm256_set1_ps(dt));
+    const __m256 forward = _mm256_cmp_ps(d, zero, _CMP_GT_OQ);
+    const __m256 moving = _mm256_cmp_ps(d, zero, _CMP_NEQ_UQ);
+
+    // sweep_tile_span(): lines a0..a1 along the move, c0..c1 across it.
+    const __m256 lead = _mm256_add_ps(a, size);
+    const __m256i a0 = tile_floor8(_mm256_blendv_ps(_mm256_add_ps(a, d), lead, forward));
+    const __m256i last =
+        tile_floor8(_mm256_blendv_ps(_mm256_xor_ps(a, _mm256_set1_ps(-0.0f)), _mm256_add_ps(lead, d), forward));
+    const __m256i a1 =
+        _mm256_blendv_epi8(_mm256_xor_si256(last, _mm256_set1_epi32(-1)), last, _mm256_castps_si256(forward));
+    const __m256i c0 = tile_floor8(c);
+    const __m256i c1 = _mm256_sub_epi32(tile_ceil8(_mm256_add_ps(c, across_size)), one);
+    const __m256i has_b = _mm256_cmpgt_epi32(a1, a0);
+    const __m256i has_c1 = _mm256_cmpgt_epi32(c1, c0);
+    // Spans past 2x2 tiles take the scalar path.
+    __m256i scalar = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_sub_epi32(a1, a0), one),
+                                     _mm256_cmpgt_epi32(_mm256_sub_epi32(c1, c0), one));
+
+    const __m256i moving_i = _mm256_castps_si256(moving);
+    __m256 solid_a0, solid_b0, solid_a1, solid_b1;
+    if (x_axis) {
+        // One row word per tile across, lines A and B side by side.
+        const __m256i row0 = solid_pairs8(map, a0, c0, moving_i, scalar);
+        const __m256i row1 =
+            solid_pairs8(map, a0, _mm256_add_epi32(c0, one), _mm256_and_si256(moving_i, has_c1), scalar);
+        solid_a0 = bit8(row0, 1);
+        solid_b0 = bit8(row0, 2);
+        solid_a1 = bit8(row1, 1);
+        solid_b1 = bit8(row1, 2);
+    } else {
+        // One row word per line, the tiles across side by side.
+        const __m256i row_a = solid_pairs8(map, c0, a0, moving_i, scalar);
+        const __m256i row_b =
+            solid_pairs8(map, c0, _mm256_add_epi32(a0, one), _mm256_and_si256(moving_i, has_b), scalar);
+        solid_a0 = bit8(row_a, 1);
+        solid_a1 = bit8(row_a, 2);
+        solid_b0 = bit8(row_b, 1);
+        solid_b1 = bit8(row_b, 2);
+    }
+
+    const __m256 lo_a = tile_pixels8(a0);
+    const __m256 lo_b = tile_pixels8(_mm256_add_epi32(a0, one));
+    const __m256 over0 = overlaps8(c, across_size, tile_pixels8(c0));
+    const __m256 over1 = _mm256_and_ps(overlaps8(c, across_size, tile_pixels8(_mm256_add_epi32(c0, one))),
+                                       _mm256_castsi256_ps(has_c1));
+    const __m256 line_a = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a0, a1)), moving);
+    const __m256 line_b = _mm256_and_ps(_mm256_castsi256_ps(has_b), moving);
+    const __m256 hit_a = _mm256_and_ps(_mm256_and_ps(line_a, line_hit8(a, d, size, lo_a)),
+                                       _mm256_or_ps(_mm256_and_ps(solid_a0, over0), _mm256_and_ps(solid_a1, over1)));
+    const __m256 hit_b = _mm256_and_ps(_mm256_and_ps(line_b, line_hit8(a, d, size, lo_b)),
+                                       _mm256_or_ps(_mm256_and_ps(solid_b0, over0), _mm256_and_ps(solid_b1, over1)));
+
+    // The nearer line wins: A moving forward, B moving back.
+    const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    const __m256 use_b = _mm256_blendv_ps(hit_b, _mm256_andnot_ps(hit_a, all), forward);
+    const __m256 lo = _mm256_blendv_ps(lo_a, lo_b, use_b);
+    const __m256 stop = _mm256_blendv_ps(_mm256_add_ps(lo, ts), _mm256_sub_ps(lo, size), forward);
+    const __m256 blocked = _mm256_or_ps(hit_a, hit_b);
+    _mm256_storeu_ps(pos, _mm256_blendv_ps(_mm256_add_ps(a, d), stop, blocked));
+    const unsigned blocked_lanes = static_cast<unsigned>(_mm256_movemask_ps(blocked));
+    const unsigned scalar_lanes = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(scalar)));
+    if (!scalar_lanes) return blocked_lanes;
+    // Rerun those lanes from where they started.
+    alignas(32) float start[8];
+    _mm256_store_ps(start, a);
+    for (unsigned l = 0; l < 8; ++l) {
+        if (scalar_lanes & (1u << l)) pos[l] = start[l];
+    }
+    return sweep_lanes(map, b, i, scalar_lanes, dt, x_axis, blocked_lanes);
+}
+
+#endif // GAME_TILE_SWEEP_AVX2
+
+} // namespace
+
+void sweep_actors(const TileMap& map, const SweepBodies<float>& b, std::uint32_t begin, std::uint32_t end, float dt,
+                  SimdLevel level) {
+    std::uint32_t i = begin;
+#if GAME_TILE_SWEEP_AVX2
+    if (level == SimdLevel::Avx2 && gatherable(map)) {
+        for (; end - i >= 8; i += 8) {
+            const unsigned blocked_x = sweep_axis8(map, b, i, dt, true);
+            const unsigned blocked_y = sweep_axis8(map, b, i, dt, false);
+            for (unsigned l = 0; l < 8; ++l) {
+                b.blocked[i + l] = static_cast<std::uint8_t>(((blocked_x >> l) & 1u) * kBlockedX |
+                                                             ((blocked_y >> l) & 1u) * kBlockedY);
+            }
+        }
+    }
+#else
+    (void)level;
+#endif
+    // Remainder actors (and every actor below AVX2).
+    sweep_actor_range(map, b, i, end, dt);
+}
+
+} // namespace game
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/cpu_features.hpp"
+#include "core/fixed.hpp"
+#include "sim/physics.hpp"
+
+namespace game {
+
+// sweep_actor_range() vectorised across actors: with AVX2, 8 actors sweep
+// each axis at once, every lane gathering the solid rows of the 2x2 tiles
+// ahead of it and picking the nearest hit with masks instead of branches.
+// Lanes whose move covers more tiles than that, and the remainder, take the
+// scalar path, as does every actor below AVX2. Both run the same IEEE
+// operations as sweep_aabb(), so the results are bit-identical.
+void sweep_actors(const TileMap& map, const SweepBodies<float>& b, std::uint32_t begin, std::uint32_t end, float dt,
+                  SimdLevel level);
+
+// Fixed-point actors run the scalar path.
+inline void sweep_actors(const TileMap& map, const SweepBodies<Fixed>& b, std::uint32_t begin, std::uint32_t end,
+                         Fixed dt, SimdLevel) {
+    sweep_actor_range(map, b, begin, end, dt);
+}
+
+} // namespace game
@@ -0,0 +1,102 @@
+#include "sim/tilemap.hpp"
+
+#include <algorithm>
+
+namespace game {
+
+namespace {
+
+TileChunk make_solid_chunk() {
+    TileChunk c;
+    c.tiles.fill(Tile::Solid);
+    c.solid_rows.fill(~0u);
+    return c;
+}
+
+} // namespace
+
+TileMap::TileMap(int width, int height)
+    : width_(width),
+      height_(height),
+      chunks_x_((width + TileChunk::kMask) >> TileChunk::kShift),
+      chunks_y_((height + TileChunk::kMask) >> TileChunk::kShift) {
+    const std::size_t n = static_cast<std::size_t>(chunks_x_) * chunks_y_;
+    storage_.resize(n + 1);
+    storage_[0] = make_solid_chunk();
+    slots_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) slots_[i] = static_cast<std::uint32_t>(i + 1);
+}
+
+TileMap TileMap::streamed(int width, int height, int resident_chunks) {
+    TileMap map;
+    map.width_ = width;
+    map.height_ = height;
+    map.chunks_x_ = (width + TileChunk::kMask) >> TileChunk::kShift;
+    map.chunks_y_ = (height + TileChunk::kMask) >> TileChunk::kShift;
+    map.storage_.resize(static_cast<std::size_t>(resident_chunks) + 1);
+    map.storage_[0] = make_solid_chunk();
+    map.slots_.assign(static_cast<std::size_t>(map.chunks_x_) * map.chunks_y_, 0);
+    // Popped from the back, so slots fill in order.
+    map.free_slots_.reserve(static_cast<std::size_t>(resident_chunks));
+    for (int i = resident_chunks; i >= 1; --i) map.free_slots_.push_back(static_cast<std::uint32_t>(i));
+    return map;
+}
+
+bool TileMap::page_in(int cx, int cy, const Tile* tiles) {
+    std::uint32_t& slot = slots_[static_cast<std::size_t>(cy) * chunks_x_ + cx];
+    if (slot == 0) {
+        if (free_slots_.empty()) return false;
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    // The slot keeps counting revisions across the chunks it holds, so a
+    // cache keyed on its address sees every new occupant as a change.
+    TileChunk& c = storage_[slot];
+    std::copy_n(tiles, c.tiles.size(), c.tiles.begin());
+    for (int y = 0; y < TileChunk::kSize; ++y) {
+        std::uint32_t row = 0;
+        for (int x = 0; x < TileChunk::kSize; ++x) {
+            if (c.tiles[static_cast<std::size_t>(y * TileChunk::kSize + x)] != Tile::Empty) row |= 1u << x;
+        }
+        c.solid_rows[static_cast<std::size_t>(y)] = row;
+    }
+    ++c.revision;
+    return true;
+}
+
+void TileMap::page_out(int cx, int cy) {
+    std::uint32_t& slot = slots_[static_cast<std::size_t>(cy) * chunks_x_ + cx];
+    if (slot == 0) return;
+    free_slots_.push_back(slot);
+    slot = 0;
+}
+
+TileMap TileMap::from_ascii(const std::vector<std::string>& rows) {
+    std::size_t width = 0;
+    for (const std::string& row : rows) width = std::max(width, row.size());
+
+    TileMap map(static_cast<int>(width), static_cast<int>(rows.size()));
+    for (std::size_t y = 0; y < rows.size(); ++y) {
+        for (std::size_t x = 0; x < rows[y].size(); ++x) {
+            if (rows[y][x] == '#') map.set(static_cast<int>(x), static_cast<int>(y), Tile::Solid);
+        }
+    }
+    return map;
+}
+
+void TileMap::set(int tx, int ty, Tile tile) {
+    if (tx < 0 || ty < 0 || tx >= width_ || ty >= height_) return;
+    const std::uint32_t slot = slots_[static_cast<std::size_t>(ty >> TileChunk::kShift) * chunks_x_ +
+                                      (tx >> TileChunk::kShift)];
+    if (slot == 0) return;
+    TileChunk& c = storage_[slot];
+    Tile& t = c.tiles[((ty & TileChunk::kMask) << TileChunk::kShift) | (tx & TileChunk::kMask)];
+    if (t == tile) return;
+    t = tile;
+    const std::uint32_t bit = 1u << (tx & TileChunk::kMask);
+    std::uint32_t& row = c.solid_rows[ty & TileChunk::kMask];
+    row = tile == Tile::Empty ? (row & ~bit) : (row | bit);
+    ++c.revision;
+}
+
+} // namespace game
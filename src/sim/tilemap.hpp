@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game {
+
+enum class Tile : std::uint8_t {
+    Empty = 0,
+    Solid = 1,
+};
+
+// Fixed-size square block of tiles. Chunks are the unit of storage (and later
+// of caching and streaming); a tile lookup is one chunk index plus one offset.
+struct TileChunk {
+    static constexpr int kShift = 5;
+    static constexpr int kSize = 1 << kShift;  // tiles per side
+    static constexpr int kMask = kSize - 1;
+
+    std::array<Tile, kSize * kSize> tiles{};
+    // One bit per tile, one word per row, mirroring tiles[] != Empty. Collision
+    // only asks "is it solid", and this keeps that working set tiny.
+    std::array<std::uint32_t, kSize> solid_rows{};
+    std::uint32_t revision = 0;  // bumped on every edit
+};
+static_assert(TileChunk::kSize == 32, "solid_rows packs one row into a 32-bit word");
+
+// A level's tiles, stored as chunks. Usually every chunk is resident; a
+// streamed map instead has a fixed number of chunk slots that a
+// LevelStreamer pages chunks in and out of, and chunks that are not resident
+// read as solid, like tiles outside the map. Either way a lookup is one
+// chunk-table load plus one offset.
+class TileMap {
+public:
+    static constexpr int kTileSize = 16;
+
+    TileMap() = default;
+    // Every chunk resident, all tiles empty.
+    TileMap(int width, int height);
+    // No chunk resident, with room for `resident_chunks` of them.
+    static TileMap streamed(int width, int height, int resident_chunks);
+
+    // Builds a map from rows of text: '#' is solid, anything else is empty.
+    static TileMap from_ascii(const std::vector<std::string>& rows);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int chunks_x() const { return chunks_x_; }
+    int chunks_y() const { return chunks_y_; }
+
+    // Tiles outside the map read as solid so actors cannot leave the level.
+    Tile at(int tx, int ty) const {
+        if (tx < 0 || ty < 0 || tx >= width_ || ty >= height_) return Tile::Solid;
+        const TileChunk& c = chunk(tx >> TileChunk::kShift, ty >> TileChunk::kShift);
+        return c.tiles[((ty & TileChunk::kMask) << TileChunk::kShift) | (tx & TileChunk::kMask)];
+    }
+    bool solid(int tx, int ty) const {
+        if (tx < 0 || ty < 0 || tx >= width_ || ty >= height_) return true;
+        const TileChunk& c = chunk(tx >> TileChunk::kShift, ty >> TileChunk::kShift);
+        return (c.solid_rows[ty & TileChunk::kMask] >> (tx & TileChunk::kMask)) & 1u;
+    }
+    // Edits to chunks that are not resident are dropped.
+    void set(int tx, int ty, Tile tile);
+
+    // A chunk that is not resident is an all-solid placeholder shared by
+    // every such chunk.
+    const TileChunk& chunk(int cx, int cy) const {
+        return storage_[slots_[static_cast<std::size_t>(cy) * chunks_x_ + cx]];
+    }
+    bool resident(int cx, int cy) const { return slots_[static_cast<std::size_t>(cy) * chunks_x_ + cx] != 0; }
+
+    // page_in() copies a chunk's TileChunk::kSize^2 tiles (row-major) into
+    // its slot, taking a free one if it is not resident, and fails if none
+    // is free. page_out() frees the chunk's slot. Neither allocates.
+    bool page_in(int cx, int cy, const Tile* tiles);
+    void page_out(int cx, int cy);
+    int resident_chunks() const { return static_cast<int>(storage_.size() - 1 - free_slots_.size()); }
+    int chunk_slots() const { return storage_.empty() ? 0 : static_cast<int>(storage_.size() - 1); }
+
+    // The tables chunk() reads, for vector code that gathers tile rows
+    // itself: chunk (cx, cy) is chunk_storage()[slot_table()[cy * chunks_x() + cx]].
+    const std::uint32_t* slot_table() const { return slots_.data(); }
+    const TileChunk* chunk_storage() const { return storage_.data(); }
+    std::size_t slot_count() const { return slots_.size(); }
+    std::size_t chunk_storage_size() const { return storage_.size(); }
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    int chunks_x_ = 0;
+    int chunks_y_ = 0;
+    // storage_[0] is the solid placeholder; slots_ maps every chunk of the
+    // map to its storage_ index, 0 when it is not resident.
+    std::vector<TileChunk> storage_;
+    std::vector<std::uint32_t> slots_;
+    std::vector<std::uint32_t> free_slots_;
+};
+
+} // namespace game
@@ -0,0 +1,419 @@
+#include "sim/world.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+#include "core/hash.hpp"
+#include "core/job_system.hpp"
+#include "core/profiler.hpp"
+#include "core/rng.hpp"
+#include "sim/physics.hpp"
+#include "sim/tile_sweep.hpp"
+
+namespace game {
+
+namespace {
+
+constexpr float kGravity = 1800.0f;
+constexpr float kMaxFallSpeed = 900.0f;
+constexpr float kRunSpeed = 160.0f;
+constexpr float kGroundAccel = 2000.0f;
+constexpr float kAirAccel = 1000.0f;
+constexpr float kJumpSpeed = 520.0f;
+constexpr float kJumpCutFactor = 0.5f;
+
+constexpr Vec2 kEnemySize{14.0f, 14.0f};
+constexpr float kEnemySpeed = 60.0f;
+constexpr float kEnemyFireInterval = 2.0f;
+constexpr Vec2 kProjectileSize{4.0f, 4.0f};
+constexpr float kProjectileSpeed = 240.0f;
+constexpr Vec2 kPickupSize{8.0f, 8.0f};
+
+constexpr int kSparksPerContact = 4;
+constexpr float kSparkSpeed = 90.0f;
+constexpr float kSparkLife = 0.35f;
+// Spark colour per ContactKind.
+constexpr std::uint32_t kSparkColors[] = {0xffd080ffu, 0xff6050ffu, 0xfff070ffu};
+
+// Tile sweeps run over ranges of about this many actors, and at most
+// kMaxSweepChunks of them. The split depends only on the actor count, so the
+// result does not depend on how many threads run the ranges.
+constexpr std::uint32_t kSweepChunkActors = 512;
+constexpr std::uint32_t kMaxSweepChunks = 64;
+// Minimum items per job for the simple per-element loops.
+constexpr std::uint32_t kActorGrain = 4096;
+
+std::uint32_t sweep_chunk_count(std::uint32_t actors) {
+    const std::uint32_t chunks = (actors + kSweepChunkActors - 1) / kSweepChunkActors;
+    return chunks < 1 ? 1 : (chunks > kMaxSweepChunks ? kMaxSweepChunks : chunks);
+}
+
+constexpr float kGridCellSize = 4.0f * TileMap::kTileSize;
+
+} // namespace
+
+World::World(TileMap map, Vec2 spawn) : map_(std::move(map)) {
+    assert(fits(map_) && "level too large for this build's Real");
+    grid_.reset(static_cast<float>(map_.width() * TileMap::kTileSize),
+                static_cast<float>(map_.height() * TileMap::kTileSize), kGridCellSize);
+    reserve(1);
+    player_ = actors_.spawn(ActorKind::Player, spawn, {kPlayerWidth, kPlayerHeight}, {}, kActorGravity);
+    refresh_grid();
+}
+
+void World::reserve(std::size_t actors) {
+    if (actors <= actor_capacity_) return;
+    actor_capacity_ = actors;
+    const std::size_t n = actors + kMaxProjectiles;
+    actors_.reserve(n);
+    grid_.reserve(n);
+    sweep_blocked_.reserve(n);
+    contacts_.reserve(n);
+    spark_bursts_.reserve(n);
+}
+
+namespace {
+
+template <typename T>
+std::uint64_t hash_column(const std::vector<T>& column, std::uint64_t h) {
+    return fnv1a64(column.data(), column.size() * sizeof(T), h);
+}
+
+// Flat serialisers for snapshot state: plain values, and arrays as an
+// element count followed by the raw elements.
+struct StateSize {
+    std::size_t bytes = 0;
+    template <typename T>
+    void value(const T&) {
+        bytes += sizeof(T);
+    }
+    template <typename T>
+    void array(const T*, std::size_t n) {
+        bytes += sizeof(std::uint32_t) + n * sizeof(T);
+    }
+};
+
+struct StateWriter {
+    std::uint8_t* p;
+    template <typename T>
+    void value(const T& v) {
+        std::memcpy(p, &v, sizeof(T));
+        p += sizeof(T);
+    }
+    template <typename T>
+    void array(const T* data, std::size_t n) {
+        value(static_cast<std::uint32_t>(n));
+        if (n > 0) std::memcpy(p, data, n * sizeof(T));
+        p += n * sizeof(T);
+    }
+};
+
+struct StateReader {
+    const std::uint8_t* p;
+    template <typename T>
+    void value(T& v) {
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+    }
+    std::size_t count() {
+        std::uint32_t n = 0;
+        value(n);
+        return n;
+    }
+    template <typename T>
+    void elements(T* data, std::size_t n) {
+        if (n > 0) std::memcpy(data, p, n * sizeof(T));
+        p += n * sizeof(T);
+    }
+};
+
+} // namespace
+
+template <typename Out>
+void World::write_state(Out& out) const {
+    out.value(tick_);
+    out.value(player_);
+    out.value(pickups_collected_);
+    out.value(player_hits_);
+    out.value(player_jumps_);
+    out.value(projectile_count_);
+    actors_.for_each_column([&](const auto& column) { out.array(column.data(), column.size()); });
+    particles_.for_each_column([&](const auto* column) { out.array(column, particles_.size()); });
+}
+
+std::size_t World::state_bytes() const {
+    StateSize size;
+    write_state(size);
+    return size.bytes;
+}
+
+void World::save_state(std::uint8_t* out) const {
+    StateWriter writer{out};
+    write_state(writer);
+}
+
+void World::load_state(const std::uint8_t* in) {
+    StateReader reader{in};
+    reader.value(tick_);
+    reader.value(player_);
+    reader.value(pickups_collected_);
+    reader.value(player_hits_);
+    reader.value(player_jumps_);
+    reader.value(projectile_count_);
+    actors_.for_each_column([&](auto& column) {
+        column.resize(reader.count());
+        reader.elements(column.data(), column.size());
+    });
+    std::size_t particles = 0;
+    particles_.for_each_column([&](auto* column) {
+        particles = reader.count();
+        reader.elements(column, particles);
+    });
+    particles_.resize(particles);
+
+    actors_.prev_x.assign(actors_.x.begin(), actors_.x.end());
+    actors_.prev_y.assign(actors_.y.begin(), actors_.y.end());
+    contacts_.clear();
+    pending_projectiles_.clear();
+    refresh_grid();
+}
+
+void World::refresh_grid() {
+    grid_.build(actors_.x.data(), actors_.y.data(), actors_.w.data(), actors_.h.data(), actors_.size());
+}
+
+void World::set_tile(int tx, int ty, Tile tile) {
+    const Tile before = map_.at(tx, ty);
+    if (before == tile) return;
+    map_.set(tx, ty, tile);
+    // Out-of-map and non-resident tiles ignore the edit.
+    if (map_.at(tx, ty) == tile) tile_edits_.push({tx, ty, before});
+}
+
+std::uint64_t World::checksum() const {
+    std::uint64_t h = fnv1a64(&tick_, sizeof tick_);
+    h = fnv1a64(&pickups_collected_, sizeof pickups_collected_, h);
+    h = fnv1a64(&player_hits_, sizeof player_hits_, h);
+    h = hash_column(actors_.x, h);
+    h = hash_column(actors_.y, h);
+    h = hash_column(actors_.vel_x, h);
+    h = hash_column(actors_.vel_y, h);
+    h = hash_column(actors_.timer, h);
+    h = hash_column(actors_.kind, h);
+    h = hash_column(actors_.flags, h);
+    // Particle by particle, so the bytes hashed (and the checksums in
+    // recorded replays) are the same as when particles were stored as
+    // structs.
+    const ParticleSystem& ps = particles_;
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        h = fnv1a64(&ps.x()[i], sizeof(float), h);
+        h = fnv1a64(&ps.y()[i], sizeof(float), h);
+        h = fnv1a64(&ps.vel_x()[i], sizeof(float), h);
+        h = fnv1a64(&ps.vel_y()[i], sizeof(float), h);
+        h = fnv1a64(&ps.life()[i], sizeof(float), h);
+    }
+    return h;
+}
+
+void World::ensure_capacity(std::size_t actors) {
+    if (actors > actor_capacity_) reserve(std::max(actors, actor_capacity_ * 2));
+}
+
+ActorHandle World::spawn_enemy(Vec2 pos) {
+    ensure_capacity(actors_.size() + 1);
+    // Stagger the first shot so a freshly populated level does not fire in
+    // lockstep.
+    const ActorHandle h = actors_.spawn(ActorKind::Enemy, pos, kEnemySize, {kEnemySpeed, 0.0f}, kActorGravity);
+    actors_.timer[actors_.slot(h)] = kEnemyFireInterval * static_cast<float>(h.index % 16) / 16.0f;
+    return h;
+}
+
+ActorHandle World::spawn_projectile(Vec2 pos, Vec2 vel) {
+    ++projectile_count_;
+    return actors_.spawn(ActorKind::Projectile, pos, kProjectileSize, vel);
+}
+
+ActorHandle World::spawn_pickup(Vec2 pos) {
+    ensure_capacity(actors_.size() + 1);
+    return actors_.spawn(ActorKind::Pickup, pos, kPickupSize, {}, kActorGravity);
+}
+
+void World::apply_input(const InputState& input, float dt) {
+    GAME_PROFILE_SCOPE("input");
+    const std::size_t n = actors_.size();
+    std::copy_n(actors_.x.begin(), n, actors_.prev_x.begin());
+    std::copy_n(actors_.y.begin(), n, actors_.prev_y.begin());
+
+    const std::uint32_t p = actors_.slot(player_);
+    Real& vx = actors_.vel_x[p];
+    Real& vy = actors_.vel_y[p];
+    std::uint8_t& flags = actors_.flags[p];
+    const bool on_ground = (flags & kActorOnGround) != 0;
+
+    float target = 0.0f;
+    if (input.held(kButtonLeft)) target -= kRunSpeed;
+    if (input.held(kButtonRight)) target += kRunSpeed;
+    vx = approach(vx, Real(target), Real((on_ground ? kGroundAccel : kAirAccel) * dt));
+
+    const Real cut(-kJumpSpeed * kJumpCutFactor);
+    if (input.held(kButtonJump) && on_ground) {
+        vy = Real(-kJumpSpeed);
+        flags &= static_cast<std::uint8_t>(~kActorOnGround);
+        ++player_jumps_;
+    } else if (!input.held(kButtonJump) && vy < cut) {
+        // Releasing jump early gives a shorter hop.
+        vy = cut;
+    }
+}
+
+void World::integrate(float dt) {
+    GAME_PROFILE_SCOPE("update");
+    const std::size_t n = actors_.size();
+    Real* vel_y = actors_.vel_y.data();
+    const std::uint8_t* flags = actors_.flags.data();
+    const Real fall(kGravity * dt);
+    parallel_for(jobs_, static_cast<std::uint32_t>(n), kActorGrain, [=](std::uint32_t begin, std::uint32_t end) {
+        apply_gravity(vel_y, flags, begin, end, fall, Real(kMaxFallSpeed));
+    });
+
+    // Sparks fall with the actors' gravity, without the fall-speed cap.
+    particles_.update(dt, kGravity, jobs_);
+
+    // Enemy behaviour: fire a projectile in the facing direction on a timer.
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (actors_.kind[i] != ActorKind::Enemy) continue;
+        actors_.timer[i] -= dt;
+        if (actors_.timer[i] > 0.0f) continue;
+        actors_.timer[i] += kEnemyFireInterval;
+        if (projectile_count_ + pending_projectiles_.size() >= kMaxProjectiles) continue;
+        const Aabb box = actors_.bounds(i);
+        const float dir = actors_.vel_x[i] < Real() ? -1.0f : 1.0f;
+        const float px = dir < 0.0f ? box.x - kProjectileSize.x : box.x + box.w;
+        pending_projectiles_.push(
+            {{px, box.y + box.h * 0.5f - kProjectileSize.y * 0.5f}, {dir * kProjectileSpeed, 0.0f}});
+    }
+}
+
+void World::collide(float dt) {
+    GAME_PROFILE_SCOPE("collision");
+    // Resolve x, then y, sweeping every moving actor against the solid tiles
+    // its move covers. Neither axis's response changes what the other axis
+    // reads, so both are applied after the sweep.
+    const std::uint32_t n = static_cast<std::uint32_t>(actors_.size());
+    contacts_.clear();
+    sweep_tiles(dt);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        actors_.flags[i] &= static_cast<std::uint8_t>(~kActorOnGround);
+        const std::uint8_t blocked = sweep_blocked_[i];
+        if (blocked & kBlockedX) {
+            switch (actors_.kind[i]) {
+            case ActorKind::Enemy:
+                actors_.vel_x[i] = -actors_.vel_x[i];
+                break;
+            case ActorKind::Projectile:
+                add_contact(ContactKind::ProjectileBlocked, i, {});
+                break;
+            default:
+                actors_.vel_x[i] = Real();
+                break;
+            }
+        }
+        if (blocked & kBlockedY) {
+            if (actors_.vel_y[i] > Real()) actors_.flags[i] |= kActorOnGround;
+            actors_.vel_y[i] = Real();
+        }
+    }
+
+    {
+        GAME_PROFILE_SCOPE("grid");
+        refresh_grid();
+    }
+    resolve_contacts();
+    // Destroying swap-removes and spawning appends, so either leaves the
+    // grid's slots stale for the renderer.
+    const bool reshaped = !contacts_.empty() || !pending_projectiles_.empty();
+    flush_pending();
+    if (reshaped) {
+        GAME_PROFILE_SCOPE("grid");
+        refresh_grid();
+    }
+    ++tick_;
+}
+
+void World::sweep_tiles(float dt) {
+    GAME_PROFILE_SCOPE("sweep");
+    const std::uint32_t n = static_cast<std::uint32_t>(actors_.size());
+    sweep_blocked_.resize(n);
+    const std::uint32_t chunks = sweep_chunk_count(n);
+    parallel_for(jobs_, chunks, 1, [&](std::uint32_t first, std::uint32_t last) {
+        for (std::uint32_t c = first; c < last; ++c) {
+            const auto begin = static_cast<std::uint32_t>(static_cast<std::uint64_t>(n) * c / chunks);
+            const auto end = static_cast<std::uint32_t>(static_cast<std::uint64_t>(n) * (c + 1) / chunks);
+            sweep_range(begin, end, dt);
+        }
+    });
+}
+
+void World::sweep_range(std::uint32_t begin, std::uint32_t end, float dt) {
+    const SweepBodies<Real> bodies{actors_.x.data(),     actors_.y.data(),     actors_.w.data(),
+                                   actors_.h.data(),     actors_.vel_x.data(), actors_.vel_y.data(),
+                                   sweep_blocked_.data()};
+    sweep_actors(map_, bodies, begin, end, Real(dt), simd_level_);
+}
+
+void World::resolve_contacts() {
+    GAME_PROFILE_SCOPE("contacts");
+    const std::uint32_t n = static_cast<std::uint32_t>(actors_.size());
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (actors_.kind[i] != ActorKind::Projectile || (actors_.flags[i] & kActorExpired)) continue;
+        const Aabb box = actors_.bounds(i);
+        std::uint32_t target = UINT32_MAX;
+        grid_.query(box, [&](std::uint32_t j) {
+            if (target != UINT32_MAX || actors_.kind[j] == ActorKind::Projectile ||
+                !overlaps(box, actors_.bounds(j))) {
+                return;
+            }
+            target = j;
+        });
+        if (target == UINT32_MAX) continue;
+        if (actors_.kind[target] == ActorKind::Player) ++player_hits_;
+        add_contact(ContactKind::ProjectileHit, i, actors_.handle_at(target));
+    }
+
+    const std::uint32_t p = actors_.slot(player_);
+    const Aabb player = actors_.bounds(p);
+    grid_.query(player, [&](std::uint32_t j) {
+        if (actors_.kind[j] == ActorKind::Pickup && overlaps(player, actors_.bounds(j))) {
+            add_contact(ContactKind::PickupCollected, j, player_);
+            ++pickups_collected_;
+        }
+    });
+}
+
+void World::add_contact(ContactKind kind, std::uint32_t slot, ActorHandle other) {
+    actors_.flags[slot] |= kActorExpired;
+    const Aabb b = actors_.bounds(slot);
+    contacts_.push({kind, actors_.handle_at(slot), other, {b.x + b.w * 0.5f, b.y + b.h * 0.5f}});
+}
+
+void World::emit_burst(Vec2 pos, int count, std::uint32_t rgba, std::uint32_t seed) {
+    particles_.emit({pos, count, kSparkSpeed, kSparkLife, rgba, seed});
+}
+
+void World::flush_pending() {
+    spark_bursts_.clear();
+    for (const Contact& c : contacts_) {
+        if (c.kind != ContactKind::PickupCollected) --projectile_count_;
+        const std::uint32_t seed = hash32(static_cast<std::uint32_t>(tick_) ^ (c.actor.index * 0x9e3779b9u));
+        spark_bursts_.push(
+            {c.pos, kSparksPerContact, kSparkSpeed, kSparkLife, kSparkColors[static_cast<int>(c.kind)], seed});
+        actors_.destroy(c.actor);
+    }
+    particles_.emit(spark_bursts_.data(), spark_bursts_.size());
+    for (const PendingSpawn& s : pending_projectiles_) spawn_projectile(s.pos, s.vel);
+    pending_projectiles_.clear();
+}
+
+} // namespace game
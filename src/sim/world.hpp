@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "core/cpu_features.hpp"
+#include "core/fixed.hpp"
+#include "core/math.hpp"
+#include "core/pool.hpp"
+#include "sim/actor_store.hpp"
+#include "sim/input.hpp"
+#include "sim/particle_system.hpp"
+#include "sim/spatial_grid.hpp"
+#include "sim/tilemap.hpp"
+
+namespace game {
+
+class JobSystem;
+
+enum class ContactKind : std::uint8_t {
+    ProjectileBlocked,  // a projectile ran into a solid tile
+    ProjectileHit,      // a projectile touched another actor (`other`)
+    PickupCollected,    // the player (`other`) touched a pickup
+};
+
+// Something the collision stage found this tick. `actor` is the projectile
+// or pickup involved; it is destroyed when the tick completes.
+struct Contact {
+    ContactKind kind;
+    ActorHandle actor;
+    ActorHandle other;  // default (invalid) for tiles
+    Vec2 pos;           // centre of `actor`
+};
+
+// A tile edit as World journals it: enough to undo it.
+struct TileEdit {
+    std::int32_t tx;
+    std::int32_t ty;
+    Tile before;
+};
+
+// Fixed-timestep simulation state. Nothing in here touches SDL, so the same
+// World runs inside the windowed game and in headless tools.
+class World {
+public:
+    static constexpr float kPlayerWidth = 12.0f;
+    static constexpr float kPlayerHeight = 14.0f;
+    // Caps on transient objects; their pools are sized once so ticks never
+    // allocate. Enemies hold fire while the projectile cap is reached, and
+    // particles past the particle capacity are dropped.
+    static constexpr std::size_t kMaxProjectiles = 4096;
+    static constexpr std::size_t kMaxParticles = 4096;  // default capacity
+    static constexpr std::size_t kMaxTileEdits = 4096;   // journal capacity
+    // Largest level side, in tiles, whose pixel coordinates Real can hold:
+    // 16.16 fixed point tops out at 32767 px.
+    static constexpr int kMaxLevelTiles = std::is_same<Real, Fixed>::value ? 32767 / TileMap::kTileSize : 1 << 20;
+    static bool fits(const TileMap& map) {
+        return map.width() <= kMaxLevelTiles && map.height() <= kMaxLevelTiles;
+    }
+
+    // `map` must fit(); load code checks that first and reports the error.
+    World(TileMap map, Vec2 spawn);
+
+    // Sizes actor storage and every per-tick buffer for `actors` actors plus
+    // kMaxProjectiles in flight. Spawning past it still works but grows the
+    // buffers, so load code should call this first.
+    void reserve(std::size_t actors);
+    void reserve_particles(std::size_t particles) { particles_.reserve(particles); }
+
+    // Splits the data-parallel parts of each stage across `jobs`; null runs
+    // everything on the calling thread. The simulation result is identical
+    // either way and at any thread count.
+    void set_job_system(JobSystem* jobs) { jobs_ = jobs; }
+    // Caps the SIMD level collide() sweeps tiles on. Every level gives
+    // bit-identical results.
+    void set_simd_level(SimdLevel level) { simd_level_ = level; }
+    SimdLevel simd_level() const { return simd_level_; }
+
+    // Advances the simulation by exactly one tick of dt seconds. The state
+    // before the call is kept so renderers can interpolate between the two.
+    void step(const InputState& input, float dt) {
+        apply_input(input, dt);
+        integrate(dt);
+        collide(dt);
+    }
+
+    // The stages step() runs, exposed separately so headless tools can time
+    // them. They must be called in this order, once each per tick.
+    void apply_input(const InputState& input, float dt);
+    void integrate(float dt);
+    void collide(float dt);  // completes the tick
+
+    // Actors spawned outside step() are filed in grid() by the next tick's
+    // collide() or by refresh_grid().
+    ActorHandle spawn_enemy(Vec2 pos);
+    ActorHandle spawn_pickup(Vec2 pos);
+    void refresh_grid();
+    // Throws `count` particles upward from pos, velocities derived from seed.
+    void emit_burst(Vec2 pos, int count, std::uint32_t rgba, std::uint32_t seed);
+
+    // Edits one tile; renderers that cache tile chunks see the chunk's
+    // revision change and redraw it. Edits that change a tile are journaled.
+    void set_tile(int tx, int ty, Tile tile);
+
+    // Tile edits since the last clear_tile_edits(), oldest first, so a
+    // RewindBuffer can undo them. Past kMaxTileEdits, edits still apply but
+    // are not journaled; tile_edits().dropped() counts them.
+    const Pool<TileEdit>& tile_edits() const { return tile_edits_; }
+    void clear_tile_edits() { tile_edits_.clear(); }
+
+    // The simulation state as one flat block of raw array copies, for
+    // snapshots: everything checksum() covers plus the actor handle tables
+    // and counters. The tile map is not included (see tile_edits()).
+    // state_bytes() is the size save_state() writes.
+    std::size_t state_bytes() const;
+    void save_state(std::uint8_t* out) const;
+    // Restores a block saved from this world. Previous positions are set to
+    // the restored ones, contacts() is cleared and the broad-phase grid is
+    // rebuilt. Does not allocate while the actor count is within reserve().
+    void load_state(const std::uint8_t* in);
+
+    const TileMap& map() const { return map_; }
+    // For the LevelStreamer, which pages chunks of a streamed map in and out
+    // between ticks.
+    TileMap& map() { return map_; }
+    const ActorStore& actors() const { return actors_; }
+    ActorHandle player() const { return player_; }
+    Vec2 player_pos() const {
+        const std::uint32_t s = actors_.slot(player_);
+        return {to_float(actors_.x[s]), to_float(actors_.y[s])};
+    }
+    std::uint64_t tick() const { return tick_; }
+    // Broad-phase grid over every actor's current position, kept up to date
+    // between ticks so renderers can cull with it.
+    const SpatialGrid& grid() const { return grid_; }
+    std::uint32_t pickups_collected() const { return pickups_collected_; }
+    std::uint32_t player_hits() const { return player_hits_; }
+    // Jumps the player has started, for sound effects. Left out of
+    // checksum() since it follows from the hashed state and input.
+    std::uint32_t player_jumps() const { return player_jumps_; }
+    // Contacts found by the last collide(), in the order they were found.
+    const Pool<Contact>& contacts() const { return contacts_; }
+    // Cosmetic sparks thrown off by contacts. Simulated with the world so
+    // replays reproduce them, but nothing collides with them.
+    const ParticleSystem& particles() const { return particles_; }
+
+    // Hash of all simulated state (actors, particles, counters, tick). Two
+    // worlds fed the same setup and input stream on the same binary must
+    // agree on it every tick; replays use it to detect divergence.
+    std::uint64_t checksum() const;
+
+    // Player position blended between the previous and current tick.
+    Vec2 interpolated_player_pos(float alpha) const {
+        const std::uint32_t s = actors_.slot(player_);
+        return lerp(Vec2{to_float(actors_.prev_x[s]), to_float(actors_.prev_y[s])},
+                    Vec2{to_float(actors_.x[s]), to_float(actors_.y[s])}, alpha);
+    }
+
+private:
+    // Moves every actor by its velocity, x then y, stopping each axis at the
+    // first solid tile in its way. Sets kBlockedX / kBlockedY in
+    // sweep_blocked_[slot] for the axes an actor stopped on. Actors are split
+    // into fixed ranges that sweep independently, in parallel when there is a
+    // job system.
+    void sweep_tiles(float dt);
+    void sweep_range(std::uint32_t begin, std::uint32_t end, float dt);
+    // Actor-vs-actor pass over the broad-phase grid: projectiles stop on the
+    // first actor they touch and the player collects pickups.
+    void resolve_contacts();
+    void add_contact(ContactKind kind, std::uint32_t slot, ActorHandle other);
+    void flush_pending();
+    // Projectiles only come from enemy fire, which counts them against
+    // kMaxProjectiles and queues them for flush_pending(); reserve() already
+    // sized the actor arrays for them, so this never allocates.
+    ActorHandle spawn_projectile(Vec2 pos, Vec2 vel);
+    void ensure_capacity(std::size_t actors);
+    // Feeds every piece of snapshot state to `out`, in save_state() order.
+    template <typename Out>
+    void write_state(Out& out) const;
+
+    struct PendingSpawn {
+        Vec2 pos;
+        Vec2 vel;
+    };
+
+    TileMap map_;
+    ActorStore actors_;
+    SpatialGrid grid_;
+    ActorHandle player_;
+    std::uint64_t tick_ = 0;
+    std::uint32_t pickups_collected_ = 0;
+    std::uint32_t player_hits_ = 0;
+    std::uint32_t player_jumps_ = 0;
+    JobSystem* jobs_ = nullptr;
+    SimdLevel simd_level_ = active_simd_level();
+    std::size_t actor_capacity_ = 0;
+    std::size_t projectile_count_ = 0;
+
+    // Scratch for sweep_tiles(), kept to avoid reallocating every tick.
+    std::vector<std::uint8_t> sweep_blocked_;
+
+    // Structural changes requested mid-pass, applied once the pass is done so
+    // the dense arrays never shift under a running loop. Every contact's
+    // actor is destroyed; each actor appears in at most one contact.
+    Pool<Contact> contacts_;
+    Pool<PendingSpawn> pending_projectiles_{kMaxProjectiles};
+    // One spark burst per flushed contact, emitted as a single batch.
+    Pool<ParticleBurst> spark_bursts_;
+    ParticleSystem particles_{kMaxParticles};
+    Pool<TileEdit> tile_edits_{kMaxTileEdits};
+};
+
+} // namespace game
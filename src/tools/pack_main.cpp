@@ -0,0 +1,62 @@
+// Offline asset packer: turns loose sprites, levels and sounds listed in a
+// manifest into the single memory-mappable pack the game loads at startup.
+//
+//   sdl_game_pack [--page-size N] <manifest.txt> <out.pack>
+//   sdl_game_pack --level <level.txt> <out.sglv>
+//
+// The second form converts one text level into a chunked level file the
+// game can stream (sdl_game --stream PATH).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "assets/level_file.hpp"
+#include "assets/loose_files.hpp"
+#include "assets/pack_builder.hpp"
+
+int main(int argc, char** argv) {
+    if (argc == 4 && std::strcmp(argv[1], "--level") == 0) {
+        game::TileMap level;
+        std::string error;
+        if (!game::load_level_text(argv[2], level, &error) || !game::save_level_file(argv[3], level, &error)) {
+            std::fprintf(stderr, "sdl_game_pack: %s\n", error.c_str());
+            return 1;
+        }
+        std::printf("%s: %dx%d tiles in %dx%d chunks\n", argv[3], level.width(), level.height(), level.chunks_x(),
+                    level.chunks_y());
+        return 0;
+    }
+
+    int page_size = 1024;
+    const char* manifest = nullptr;
+    const char* out = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--page-size") == 0 && i + 1 < argc) {
+            page_size = std::atoi(argv[++i]);
+        } else if (!manifest) {
+            manifest = argv[i];
+        } else if (!out) {
+            out = argv[i];
+        } else {
+            manifest = nullptr;
+            break;
+        }
+    }
+    if (!manifest || !out || page_size < 16) {
+        std::fprintf(stderr, "usage: sdl_game_pack [--page-size N] <manifest.txt> <out.pack>\n"
+                             "       sdl_game_pack --level <level.txt> <out.sglv>\n");
+        return 2;
+    }
+
+    game::PackBuildStats stats;
+    std::string error;
+    if (!game::build_pack(manifest, out, page_size, &stats, &error)) {
+        std::fprintf(stderr, "sdl_game_pack: %s\n", error.c_str());
+        return 1;
+    }
+    std::printf("%s: %zu sprites on %zu atlas page(s), %zu level(s), %zu sound(s)\n", out, stats.sprites,
+                stats.atlas_pages, stats.levels, stats.sounds);
+    return 0;
+}